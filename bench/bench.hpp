@@ -0,0 +1,44 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+/// Keep the compiler from optimizing away the computation of `value`
+template<typename T> inline void keep(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "g"(&value) : "memory");
+#else
+	static const volatile void *sink;
+	sink = &value;
+#endif
+}
+
+/// Run `body` `repetitions` times and print the best time per item, for `body` processing `items` items per run.
+/// Returns the best time per item in nanoseconds.
+template<typename Body> double measure(const char *name, size_t items, Body&& body, int repetitions = 15) {
+	double best = 0;
+	for (int r = 0; r < repetitions; r++) {
+		auto start = std::chrono::steady_clock::now();
+		body();
+		std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+		best = r == 0 ? elapsed.count() : std::min(best, elapsed.count());
+	}
+	std::printf("%-48s %10.3f ns/item\n", name, best / items);
+	return best / items;
+}
+
+/// `count` uniformly distributed random values in `[low, high)`, the same on every run
+template<typename T> std::vector<T> random_values(size_t count, T low = 0, T high = 1, uint32_t seed = 1) {
+	std::mt19937 generator(seed);
+	std::uniform_real_distribution<double> distribution { double(low), double(high) };
+	std::vector<T> values(count);
+	for (T& value : values) {
+		value = T(distribution(generator));
+	}
+	return values;
+}
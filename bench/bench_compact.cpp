@@ -0,0 +1,56 @@
+// Built twice, as `bench_compact_default` and as `bench_compact` with `EASE_COMPACT`,
+// to compare the speed of both modes. The `bench_compact_size` target prints the size of both executables.
+#include "ease.hpp"
+
+#include "bench.hpp"
+
+using namespace ease;
+
+template<typename T> void run(const char *type) {
+	const size_t count = 1 << 16;
+	std::vector<T> p = random_values<T>(count);
+	std::vector<T> out(count);
+	std::vector<function> curves(count);
+	std::mt19937 generator(2);
+	for (function& curve : curves) {
+		curve = function(generator() % function_count);
+	}
+	char name[64];
+
+	// A different function for each value, which stresses the instruction cache and branch prediction
+	std::snprintf(name, sizeof(name), "%s: mixed functions", type);
+	measure(name, count, [&] {
+		for (size_t i = 0; i < count; i++) {
+			out[i] = evaluate(curves[i], p[i]);
+		}
+		keep(out);
+	});
+
+	std::snprintf(name, sizeof(name), "%s: batch of each function", type);
+	measure(name, count * function_count, [&] {
+		for (int f = 0; f < function_count; f++) {
+			evaluate(function(f), p.data(), out.data(), count);
+		}
+		keep(out);
+	});
+
+	std::snprintf(name, sizeof(name), "%s: interpolate_angles of each function", type);
+	std::vector<T> from = random_values<T>(count, 0, 6, 3), to = random_values<T>(count, 0, 6, 4);
+	measure(name, count * function_count, [&] {
+		for (int f = 0; f < function_count; f++) {
+			interpolate_angles(function(f), from.data(), to.data(), p.data(), out.data(), count);
+		}
+		keep(out);
+	});
+}
+
+int main() {
+#ifdef EASE_COMPACT
+	std::printf("compact mode\n");
+#else
+	std::printf("default mode\n");
+#endif
+	run<float>("float");
+	run<double>("double");
+	return 0;
+}
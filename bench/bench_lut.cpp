@@ -0,0 +1,53 @@
+// Quadratic tables held in registers against the same tables looked up from memory, an adaptive table and exact evaluation.
+// Build with `EASE_BENCHMARK_NATIVE` so the register permutes use AVX2 or AVX-512 when the host supports them.
+#include "ease.hpp"
+#include "ease_lut.hpp"
+
+#include "bench.hpp"
+
+using namespace ease;
+
+template<int N> void run_quadratic(function f, const char *function_name, const std::vector<float>& p, std::vector<float>& out) {
+	quadratic_table<N> table = quadratic_table<N>::build(f);
+	char name[64];
+	std::snprintf(name, sizeof(name), "%s: quadratic_table<%d> in registers", function_name, N);
+	measure(name, p.size(), [&] {
+		evaluate(table, p.data(), out.data(), p.size());
+		keep(out);
+	});
+	std::snprintf(name, sizeof(name), "%s: quadratic_table<%d> in memory", function_name, N);
+	measure(name, p.size(), [&] {
+		for (size_t i = 0; i < p.size(); i++) {
+			out[i] = table(p[i]);
+		}
+		keep(out);
+	});
+}
+
+void run(function f, const char *function_name) {
+	const size_t count = 1 << 16;
+	std::vector<float> p = random_values<float>(count);
+	std::vector<float> out(count);
+	run_quadratic<16>(f, function_name, p, out);
+	run_quadratic<32>(f, function_name, p, out);
+
+	adaptive_table<float> adaptive = adaptive_table<float>::build(f, 1e-3);
+	char name[64];
+	std::snprintf(name, sizeof(name), "%s: adaptive_table, %zu values", function_name, adaptive.size());
+	measure(name, count, [&] {
+		evaluate(adaptive, p.data(), out.data(), count);
+		keep(out);
+	});
+	std::snprintf(name, sizeof(name), "%s: exact", function_name);
+	measure(name, count, [&] {
+		evaluate(f, p.data(), out.data(), count);
+		keep(out);
+	});
+}
+
+int main() {
+	run(OUT_BOUNCE, "OUT_BOUNCE");
+	run(OUT_ELASTIC, "OUT_ELASTIC");
+	run(IN_OUT_ELASTIC, "IN_OUT_ELASTIC");
+	return 0;
+}
@@ -0,0 +1,71 @@
+// Tween pool updates and property overwrites with 100k live tweens.
+// Overwrites find the running tween through the pool's (target, property) index, compared here with a linear scan.
+#include "ease_tween.hpp"
+
+#include "bench.hpp"
+
+using namespace ease;
+
+int main() {
+	const size_t tween_count = 100000, call_count = 10000;
+	std::vector<float> destinations(tween_count);
+	std::vector<int> targets(tween_count);
+	std::vector<uint32_t> properties(call_count);
+	std::mt19937 generator(1);
+	for (uint32_t& property : properties) {
+		property = generator() % tween_count;
+	}
+
+	tween_pool<float> pool;
+	for (size_t i = 0; i < tween_count; i++) {
+		tween_id id = pool.animate(&targets[i], 0, function(i % function_count), 0, 1, 1000);
+		pool.bind(id, &destinations[i]);
+	}
+	pool.update(1);
+
+	measure("update, 100k bound tweens", tween_count, [&] {
+		pool.update(1);
+		keep(destinations);
+	});
+	measure("find", call_count, [&] {
+		tween_id found = 0;
+		for (uint32_t property : properties) {
+			found ^= pool.find(&targets[property], 0);
+		}
+		keep(found);
+	});
+	measure("animate, overwrite::replace", call_count, [&] {
+		for (uint32_t property : properties) {
+			pool.animate(&targets[property], 0, OUT_CUBIC, 0, 1, 1000, overwrite::replace);
+		}
+	});
+	measure("animate, overwrite::blend", call_count, [&] {
+		for (uint32_t property : properties) {
+			pool.animate(&targets[property], 0, OUT_CUBIC, 0, 1, 1000, overwrite::blend);
+		}
+	});
+	// Queued tweens stay in the pool, so queue once per property
+	measure("animate, overwrite::queue", call_count, [&] {
+		for (size_t i = 0; i < call_count; i++) {
+			pool.animate(&targets[i], 0, OUT_CUBIC, 0, 1, 1000, overwrite::queue);
+		}
+	}, 1);
+	measure("update, 100k bound tweens and 10k queued", tween_count + call_count, [&] {
+		pool.update(1);
+		keep(destinations);
+	});
+
+	// Resolving the same conflicts without an index
+	std::vector<const void *> keys(tween_count);
+	for (size_t i = 0; i < tween_count; i++) {
+		keys[i] = &targets[i];
+	}
+	measure("linear scan for the running tween", call_count, [&] {
+		size_t found = 0;
+		for (uint32_t property : properties) {
+			found ^= std::find(keys.begin(), keys.end(), &targets[property]) - keys.begin();
+		}
+		keep(found);
+	}, 3);
+	return 0;
+}
@@ -0,0 +1,39 @@
+// Throughput of ease functions in float, double, long double and, with `EASE_FLOAT128`, __float128,
+// to estimate the cost of baking curves at high precision.
+#include "ease.hpp"
+
+#include "bench.hpp"
+
+using namespace ease;
+
+template<typename T> void run(const char *type, size_t count) {
+	std::vector<T> p = random_values<T>(count);
+	std::vector<T> out(count);
+	char name[64];
+	const function functions[] = { IN_OUT_CUBIC, OUT_SINE, IN_OUT_EXPONENTIAL, OUT_ELASTIC, OUT_BOUNCE };
+	const char *names[] = { "IN_OUT_CUBIC", "OUT_SINE", "IN_OUT_EXPONENTIAL", "OUT_ELASTIC", "OUT_BOUNCE" };
+	for (int f = 0; f < 5; f++) {
+		std::snprintf(name, sizeof(name), "%s: %s", type, names[f]);
+		measure(name, count, [&] {
+			evaluate(functions[f], p.data(), out.data(), count);
+			keep(out);
+		});
+	}
+	std::snprintf(name, sizeof(name), "%s: all functions", type);
+	measure(name, count * function_count, [&] {
+		for (int f = 0; f < function_count; f++) {
+			evaluate(function(f), p.data(), out.data(), count);
+		}
+		keep(out);
+	});
+}
+
+int main() {
+	run<float>("float", 1 << 14);
+	run<double>("double", 1 << 14);
+	run<long double>("long double", 1 << 14);
+#ifdef EASE_FLOAT128
+	run<__float128>("__float128", 1 << 12);
+#endif
+	return 0;
+}
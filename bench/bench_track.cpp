@@ -0,0 +1,47 @@
+// Random access key searches in long tracks, with `eytzinger_index` against `std::upper_bound` over the sorted key times
+#include "ease_track.hpp"
+
+#include "bench.hpp"
+
+using namespace ease;
+
+template<typename T> void run(const char *type, size_t key_count) {
+	std::vector<T> times = random_values<T>(key_count, 0, T(key_count));
+	std::sort(times.begin(), times.end());
+	eytzinger_index<T> index(times.data(), key_count);
+
+	const size_t query_count = 1 << 16;
+	std::vector<T> queries = random_values<T>(query_count, 0, T(key_count), 2);
+	std::vector<uint32_t> segments(query_count);
+	char name[64];
+
+	std::snprintf(name, sizeof(name), "%s, %zu keys: std::upper_bound", type, key_count);
+	measure(name, query_count, [&] {
+		size_t sum = 0;
+		for (T query : queries) {
+			sum += std::upper_bound(times.begin(), times.end(), query) - times.begin();
+		}
+		keep(sum);
+	});
+	std::snprintf(name, sizeof(name), "%s, %zu keys: eytzinger upper_bound", type, key_count);
+	measure(name, query_count, [&] {
+		size_t sum = 0;
+		for (T query : queries) {
+			sum += index.upper_bound(query);
+		}
+		keep(sum);
+	});
+	std::snprintf(name, sizeof(name), "%s, %zu keys: eytzinger find_segments", type, key_count);
+	measure(name, query_count, [&] {
+		index.find_segments(queries.data(), query_count, segments.data());
+		keep(segments);
+	});
+}
+
+int main() {
+	for (size_t key_count : { size_t(1000), size_t(64000), size_t(1000000) }) {
+		run<float>("float", key_count);
+		run<double>("double", key_count);
+	}
+	return 0;
+}
@@ -0,0 +1,8 @@
+# Print the size of files given as FILE_1, FILE_2, ... when running with `cmake -P`
+foreach(index RANGE 1 8)
+	if(DEFINED FILE_${index})
+		file(SIZE "${FILE_${index}}" size)
+		get_filename_component(name "${FILE_${index}}" NAME)
+		message("${name}: ${size} bytes")
+	endif()
+endforeach()
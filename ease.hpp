@@ -2,17 +2,141 @@
 
 #include <cctype>
 #include <cmath>
+#include <cstddef>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 
+#ifdef EASE_FLOAT128
+#include <quadmath.h>
+#endif
+
+// Whether the current evaluation is a constant expression, available as a builtin in C++17 on most compilers
+#if defined(__has_builtin)
+	#if __has_builtin(__builtin_is_constant_evaluated)
+		#define EASE_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+	#endif
+#endif
+#if !defined(EASE_IS_CONSTANT_EVALUATED) && ((defined(__GNUC__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925))
+	#define EASE_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
 
 namespace ease {
 
 namespace detail {
-	/// Return squared value (alternative to `pow(2, ...)` used in AHEasing)
-	template<typename T> constexpr T squared(T p) {
-		return p * p;
+	/// Pi with full precision for any floating point type, including `__float128`.
+	/// Computed as the closest `long double` plus its remainder, instead of using the `double` only `M_PI` macro.
+	template<typename T> constexpr T pi() {
+		return T(3.14159265358979323851280895940618620443274267017841339111328125L) + T(-5.01655761266833202355732708e-20L);
+	}
+
+	/// Half pi with full precision for any floating point type
+	template<typename T> constexpr T half_pi() {
+		return pi<T>() / 2;
+	}
+
+	/// Natural logarithm of 2 with full precision for any floating point type, computed like `pi`
+	template<typename T> constexpr T ln2() {
+		return T(0.69314718055994530942869047418497530088643543422222137451171875L) + T(-1.145835272679873332595967058e-20L);
+	}
+
+	// Math functions calling the overload with the same precision as `T`
+	template<typename T> T sin(T p) {
+		return std::sin(p);
+	}
+	template<typename T> T cos(T p) {
+		return std::cos(p);
+	}
+	template<typename T> T sqrt(T p) {
+		return std::sqrt(p);
+	}
+	template<typename T> T exp(T p) {
+		return std::exp(p);
+	}
+	template<typename T> T log(T p) {
+		return std::log(p);
+	}
+	template<typename T> T floor(T p) {
+		return std::floor(p);
+	}
+
+	/// Difference between 1 and the next representable `T`, computed by halving so that it also works for `__float128`
+	template<typename T> constexpr T epsilon() {
+		T e = 1;
+		while (T(1) + e / 2 != T(1)) {
+			e /= 2;
+		}
+		return e;
+	}
+
+	/// Return 2 raised to `p` in constant expressions, where `std::pow` is not available.
+	/// The integer part of `p` scales by exact powers of 2 and the fractional part uses the series of `e^(f * ln 2)`.
+	template<typename T> constexpr T constexpr_power_of_two(T p) {
+		long long whole = (long long) p;
+		if (T(whole) > p) {
+			whole--;
+		}
+		T x = (p - T(whole)) * ln2<T>();
+		T sum = 1, term = 1;
+		for (int n = 1; n < 64; n++) {
+			term *= x / n;
+			T next = sum + term;
+			if (next == sum) {
+				break;
+			}
+			sum = next;
+		}
+		for (; whole > 0; whole--) {
+			sum *= 2;
+		}
+		for (; whole < 0; whole++) {
+			sum /= 2;
+		}
+		return sum;
+	}
+
+	/// Return 2 raised to `p`, as `pow(2, ...)` used in AHEasing.
+	/// Uses `std::pow` at runtime and `constexpr_power_of_two` in constant expressions,
+	/// or always `constexpr_power_of_two` on compilers that can't tell them apart.
+	template<typename T> constexpr T power_of_two(T p) {
+#ifdef EASE_IS_CONSTANT_EVALUATED
+		if (!EASE_IS_CONSTANT_EVALUATED()) {
+			return std::pow(T(2), p);
+		}
+#endif
+		return constexpr_power_of_two(p);
 	}
 
+#ifdef EASE_FLOAT128
+	// Quadruple precision math from libquadmath
+	inline __float128 sin(__float128 p) {
+		return sinq(p);
+	}
+	inline __float128 cos(__float128 p) {
+		return cosq(p);
+	}
+	inline __float128 sqrt(__float128 p) {
+		return sqrtq(p);
+	}
+	inline __float128 exp(__float128 p) {
+		return expq(p);
+	}
+	inline __float128 log(__float128 p) {
+		return logq(p);
+	}
+	inline __float128 floor(__float128 p) {
+		return floorq(p);
+	}
+	constexpr __float128 power_of_two(__float128 p) {
+#ifdef EASE_IS_CONSTANT_EVALUATED
+		if (!EASE_IS_CONSTANT_EVALUATED()) {
+			return powq(2, p);
+		}
+#endif
+		return constexpr_power_of_two(p);
+	}
+#endif
+
 	/// Returns whether 2 string views are equal, ignoring case
 	inline bool equals_ignore_case(std::string_view s1, std::string_view s2) {
 		if (s1.size() != s2.size()) {
@@ -165,27 +289,27 @@ template<typename T> constexpr T in_out_quintic(T p) {
 
 /// Modeled after quarter-cycle of sine wave
 template<typename T> T in_sine(T p) {
-	return sin((p - 1) * M_PI_2) + 1;
+	return detail::sin((p - 1) * detail::half_pi<T>()) + 1;
 }
 
 /// Modeled after quarter-cycle of sine wave (different phase)
 template<typename T> T out_sine(T p) {
-	return sin(p * M_PI_2);
+	return detail::sin(p * detail::half_pi<T>());
 }
 
 /// Modeled after half sine wave
 template<typename T> T in_out_sine(T p) {
-	return 0.5 * (1 - cos(p * M_PI));
+	return 0.5 * (1 - detail::cos(p * detail::pi<T>()));
 }
 
 /// Modeled after shifted quadrant IV of unit circle
 template<typename T> T in_circular(T p) {
-	return 1 - sqrt(1 - (p * p));
+	return 1 - detail::sqrt(1 - (p * p));
 }
 
 /// Modeled after shifted quadrant II of unit circle
 template<typename T> T out_circular(T p) {
-	return sqrt((2 - p) * p);
+	return detail::sqrt((2 - p) * p);
 }
 
 /// Modeled after the piecewise circular function
@@ -194,22 +318,22 @@ template<typename T> T out_circular(T p) {
 template<typename T> T in_out_circular(T p) {
 	if (p < 0.5)
 	{
-		return 0.5 * (1 - sqrt(1 - 4 * (p * p)));
+		return 0.5 * (1 - detail::sqrt(1 - 4 * (p * p)));
 	}
 	else
 	{
-		return 0.5 * (sqrt(-((2 * p) - 3) * ((2 * p) - 1)) + 1);
+		return 0.5 * (detail::sqrt(-((2 * p) - 3) * ((2 * p) - 1)) + 1);
 	}
 }
 
 /// Modeled after the exponential function y = 2^(10(x - 1))
 template<typename T> constexpr T in_exponential(T p) {
-	return (p == 0.0) ? p : detail::squared(10 * (p - 1));
+	return (p == 0.0) ? p : detail::power_of_two(10 * (p - 1));
 }
 
 /// Modeled after the exponential function y = -2^(-10x) + 1
 template<typename T> constexpr T out_exponential(T p) {
-	return (p == 1.0) ? p : 1 - detail::squared(-10 * p);
+	return (p == 1.0) ? p : 1 - detail::power_of_two(-10 * p);
 }
 
 /// Modeled after the piecewise exponential
@@ -220,22 +344,22 @@ template<typename T> constexpr T in_out_exponential(T p) {
 
 	if (p < 0.5)
 	{
-		return 0.5 * detail::squared((20 * p) - 10);
+		return 0.5 * detail::power_of_two((20 * p) - 10);
 	}
 	else
 	{
-		return -0.5 * detail::squared((-20 * p) + 10) + 1;
+		return -0.5 * detail::power_of_two((-20 * p) + 10) + 1;
 	}
 }
 
 /// Modeled after the damped sine wave y = sin(13pi/2*x)*pow(2, 10 * (x - 1))
 template<typename T> T in_elastic(T p) {
-	return sin(13 * M_PI_2 * p) * detail::squared(10 * (p - 1));
+	return detail::sin(13 * detail::half_pi<T>() * p) * detail::power_of_two(10 * (p - 1));
 }
 
 /// Modeled after the damped sine wave y = sin(-13pi/2*(x + 1))*pow(2, -10x) + 1
 template<typename T> T out_elastic(T p) {
-	return sin(-13 * M_PI_2 * (p + 1)) * detail::squared(-10 * p) + 1;
+	return detail::sin(-13 * detail::half_pi<T>() * (p + 1)) * detail::power_of_two(-10 * p) + 1;
 }
 
 /// Modeled after the piecewise exponentially-damped sine wave:
@@ -244,23 +368,23 @@ template<typename T> T out_elastic(T p) {
 template<typename T> T in_out_elastic(T p) {
 	if (p < 0.5)
 	{
-		return 0.5 * sin(13 * M_PI_2 * (2 * p)) * detail::squared(10 * ((2 * p) - 1));
+		return 0.5 * detail::sin(13 * detail::half_pi<T>() * (2 * p)) * detail::power_of_two(10 * ((2 * p) - 1));
 	}
 	else
 	{
-		return 0.5 * (sin(-13 * M_PI_2 * ((2 * p - 1) + 1)) * detail::squared(-10 * (2 * p - 1)) + 2);
+		return 0.5 * (detail::sin(-13 * detail::half_pi<T>() * ((2 * p - 1) + 1)) * detail::power_of_two(-10 * (2 * p - 1)) + 2);
 	}
 }
 
 /// Modeled after the overshooting cubic y = x^3-x*sin(x*pi)
 template<typename T> T in_back(T p) {
-	return p * p * p - p * sin(p * M_PI);
+	return p * p * p - p * detail::sin(p * detail::pi<T>());
 }
 
 /// Modeled after overshooting cubic y = 1-((1-x)^3-(1-x)*sin((1-x)*pi))
 template<typename T> T out_back(T p) {
 	auto f = (1 - p);
-	return 1 - (f * f * f - f * sin(f * M_PI));
+	return 1 - (f * f * f - f * detail::sin(f * detail::pi<T>()));
 }
 
 /// Modeled after the piecewise overshooting cubic function:
@@ -270,31 +394,31 @@ template<typename T> T in_out_back(T p) {
 	if (p < 0.5)
 	{
 		auto f = 2 * p;
-		return 0.5 * (f * f * f - f * sin(f * M_PI));
+		return 0.5 * (f * f * f - f * detail::sin(f * detail::pi<T>()));
 	}
 	else
 	{
 		auto f = (1 - (2*p - 1));
-		return 0.5 * (1 - (f * f * f - f * sin(f * M_PI))) + 0.5;
+		return 0.5 * (1 - (f * f * f - f * detail::sin(f * detail::pi<T>()))) + 0.5;
 	}
 }
 
 template<typename T> constexpr T out_bounce(T p) {
-	if (p < 4/11.0)
+	if (p < T(4)/11)
 	{
-		return (121 * p * p)/16.0;
+		return (121 * p * p)/16;
 	}
-	else if (p < 8/11.0)
+	else if (p < T(8)/11)
 	{
-		return (363/40.0 * p * p) - (99/10.0 * p) + 17/5.0;
+		return (T(363)/40 * p * p) - (T(99)/10 * p) + T(17)/5;
 	}
-	else if (p < 9/10.0)
+	else if (p < T(9)/10)
 	{
-		return (4356/361.0 * p * p) - (35442/1805.0 * p) + 16061/1805.0;
+		return (T(4356)/361 * p * p) - (T(35442)/1805 * p) + T(16061)/1805;
 	}
 	else
 	{
-		return (54/5.0 * p * p) - (513/25.0 * p) + 268/25.0;
+		return (T(54)/5 * p * p) - (T(513)/25 * p) + T(268)/25;
 	}
 }
 
@@ -313,8 +437,9 @@ template<typename T> constexpr T in_out_bounce(T p) {
 	}
 }
 
-/// Ease function enumeration
-enum function {
+/// Ease function enumeration.
+/// Values from `first_custom_function` on are reserved for custom ease functions, see `custom_function`.
+enum function : int {
 	LINEAR,
 
 	IN_QUADRATIC,
@@ -358,10 +483,106 @@ enum function {
 	IN_OUT_BOUNCE,
 };
 
+/// Number of values in the `function` enum
+inline constexpr int function_count = IN_OUT_BOUNCE + 1;
+
 /// Function pointer type for ease functions
 template<typename T> using function_ptr = T (*)(T);
 
-/// Get the function pointer for an ease function using an enum.
+#ifndef EASE_MAX_CUSTOM_FUNCTIONS
+/// Number of `function` values reserved for custom ease functions
+#define EASE_MAX_CUSTOM_FUNCTIONS 16
+#endif
+
+/// First `function` value reserved for custom ease functions
+inline constexpr int first_custom_function = function_count;
+
+/// Extension point for adding custom ease functions to enum based dispatch.
+/// Specialize it for values from `first_custom_function` to `first_custom_function + EASE_MAX_CUSTOM_FUNCTIONS - 1` with these members:
+/// - `template<typename T> static T evaluate(T p)`, the ease function itself
+/// - `static constexpr function_traits traits`, returned by `traits`
+/// - optionally `static constexpr std::string_view name`, matched ignoring case by `get(std::string_view)`
+/// - optionally `static constexpr double critical_points[]`, the interior extrema in increasing order, used by `bounds` and `crossings`.
+///   Functions without them are assumed to be monotone.
+///
+/// Custom functions are then supported by `get`, `evaluate`, `bounds`, `crossings`, `traits`, lookup tables and tween pools,
+/// dispatched with direct calls just like the builtin ones.
+/// Specializations must be declared before any of these are used in the translation unit.
+template<int F> struct custom_function {
+	/// Marks values without a custom ease function
+	static constexpr bool undefined = true;
+};
+
+namespace detail {
+	template<int F, typename = void> struct is_custom_function : std::true_type {};
+	template<int F> struct is_custom_function<F, std::void_t<decltype(custom_function<F>::undefined)>> : std::false_type {};
+
+	template<typename T, int F> constexpr function_ptr<T> custom_function_ptr() {
+		if constexpr (is_custom_function<F>::value) {
+			return custom_function<F>::template evaluate<T>;
+		}
+		else {
+			return nullptr;
+		}
+	}
+
+	template<typename T, typename Indices = std::make_index_sequence<EASE_MAX_CUSTOM_FUNCTIONS>> struct custom_function_table;
+	template<typename T, size_t... I> struct custom_function_table<T, std::index_sequence<I...>> {
+		static constexpr function_ptr<T> pointers[] = { custom_function_ptr<T, first_custom_function + int(I)>()... };
+	};
+
+	/// Get the function pointer for a custom ease function, or `nullptr` if there is none
+	template<typename T> constexpr function_ptr<T> get_custom(function f) {
+		int index = f - first_custom_function;
+		return index >= 0 && index < EASE_MAX_CUSTOM_FUNCTIONS ? custom_function_table<T>::pointers[index] : nullptr;
+	}
+
+	template<typename T, int F> bool evaluate_custom_at(function f, T p, T& result) {
+		if constexpr (is_custom_function<F>::value) {
+			if (f == F) {
+				result = custom_function<F>::evaluate(p);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	template<typename T, size_t... I> T evaluate_custom(function f, T p, std::index_sequence<I...>) {
+		T result = p;
+		(evaluate_custom_at<T, first_custom_function + int(I)>(f, p, result) || ...);
+		return result;
+	}
+
+	/// Evaluate a custom ease function with inlinable direct calls, behaving as `LINEAR` if there is none
+	template<typename T> T evaluate_custom(function f, T p) {
+		return evaluate_custom(f, p, std::make_index_sequence<EASE_MAX_CUSTOM_FUNCTIONS>());
+	}
+
+	template<int F, typename = void> struct has_custom_name : std::false_type {};
+	template<int F> struct has_custom_name<F, std::void_t<decltype(custom_function<F>::name)>> : std::true_type {};
+
+	template<int F, typename = void> struct has_custom_critical_points : std::false_type {};
+	template<int F> struct has_custom_critical_points<F, std::void_t<decltype(custom_function<F>::critical_points)>> : std::true_type {};
+
+	template<typename T, int F> bool get_custom_at(std::string_view name, function_ptr<T>& result) {
+		if constexpr (has_custom_name<F>::value) {
+			if (equals_ignore_case(name, custom_function<F>::name)) {
+				result = custom_function<F>::template evaluate<T>;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/// Get the function pointer for a custom ease function by name, or `nullptr` if there is none
+	template<typename T, size_t... I> function_ptr<T> get_custom(std::string_view name, std::index_sequence<I...>) {
+		function_ptr<T> result = nullptr;
+		(get_custom_at<T, first_custom_function + int(I)>(name, result) || ...);
+		return result;
+	}
+}
+
+/// Get the function pointer for an ease function using an enum, including custom ease functions.
 /// Returns `nullptr` for unknown enum values.
 template<typename T> constexpr function_ptr<T> get(function f) {
 	switch (f) {
@@ -396,14 +617,251 @@ template<typename T> constexpr function_ptr<T> get(function f) {
 		case IN_BOUNCE: return in_bounce;
 		case OUT_BOUNCE: return out_bounce;
 		case IN_OUT_BOUNCE: return in_out_bounce;
-		default: return nullptr;
+		default: return detail::get_custom<T>(f);
+	}
+}
+
+namespace detail {
+	/// Parabolas that make `out_bounce`, as `{ end, a, b, c }` for y = a*x^2 + b*x + c in the range before `end`, with the precision of `T`
+	template<typename T> inline constexpr T bounce_table[4][4] = {
+		{ T(4) / 11, T(121) / 16, 0, 0 },
+		{ T(8) / 11, T(363) / 40, T(-99) / 10, T(17) / 5 },
+		{ T(9) / 10, T(4356) / 361, T(-35442) / 1805, T(16061) / 1805 },
+		{ 1, T(54) / 5, T(-513) / 25, T(268) / 25 },
+	};
+
+	/// Shared kernel for the `in` shape of each ease function family, used by compact mode.
+	/// Families follow the `function` enum order, starting after `LINEAR`: quadratic, cubic, quartic, quintic, sine, circular, exponential, elastic, back and bounce.
+	template<typename T> T in_kernel(int family, T p) {
+		switch (family) {
+			// Polynomials, parameterized by degree
+			case 0: case 1: case 2: case 3: {
+				T result = p;
+				for (int degree = family + 2; degree > 1; degree--) {
+					result *= p;
+				}
+				return result;
+			}
+			case 4: return 1 - detail::cos(p * half_pi<T>());
+			case 5: return 1 - detail::sqrt(1 - (p * p));
+			case 6: return (p == 0.0) ? p : power_of_two(10 * (p - 1));
+			case 7: return detail::sin(13 * half_pi<T>() * p) * power_of_two(10 * (p - 1));
+			case 8: return p * p * p - p * detail::sin(p * pi<T>());
+			case 9: {
+				T f = 1 - p;
+				int i = 0;
+				while (i < 3 && f >= bounce_table<T>[i][0]) {
+					i++;
+				}
+				return 1 - ((bounce_table<T>[i][1] * f + bounce_table<T>[i][2]) * f + bounce_table<T>[i][3]);
+			}
+			default: return p;
+		}
 	}
 }
 
+/// Evaluate an ease function chosen by enum at progress `p`.
+/// Unknown enum values behave as `LINEAR`.
+///
+/// By default this dispatches to the individual ease functions.
+/// Defining `EASE_COMPACT` before including this file evaluates all functions through a few shared kernels instead:
+/// polynomials parameterized by degree, a bounce table, and `out`/`in_out` variants derived from `in` by mirroring.
+/// This trades a little speed for much less generated code, which helps instruction cache pressure in mixed workloads.
+template<typename T> T evaluate(function f, T p) {
+#ifdef EASE_COMPACT
+	if (f <= LINEAR || f >= function_count) {
+		return detail::evaluate_custom(f, p);
+	}
+	int family = (f - 1) / 3;
+	switch ((f - 1) % 3) {
+		case 0: return detail::in_kernel(family, p);
+		case 1: return 1 - detail::in_kernel(family, 1 - p);
+		default:
+			if (p < 0.5)
+			{
+				return 0.5 * detail::in_kernel<T>(family, 2 * p);
+			}
+			else
+			{
+				return 1 - 0.5 * detail::in_kernel<T>(family, 2 - 2 * p);
+			}
+	}
+#else
+	switch (f) {
+		case IN_QUADRATIC: return in_quadratic(p);
+		case OUT_QUADRATIC: return out_quadratic(p);
+		case IN_OUT_QUADRATIC: return in_out_quadratic(p);
+		case IN_CUBIC: return in_cubic(p);
+		case OUT_CUBIC: return out_cubic(p);
+		case IN_OUT_CUBIC: return in_out_cubic(p);
+		case IN_QUARTIC: return in_quartic(p);
+		case OUT_QUARTIC: return out_quartic(p);
+		case IN_OUT_QUARTIC: return in_out_quartic(p);
+		case IN_QUINTIC: return in_quintic(p);
+		case OUT_QUINTIC: return out_quintic(p);
+		case IN_OUT_QUINTIC: return in_out_quintic(p);
+		case IN_SINE: return in_sine(p);
+		case OUT_SINE: return out_sine(p);
+		case IN_OUT_SINE: return in_out_sine(p);
+		case IN_CIRCULAR: return in_circular(p);
+		case OUT_CIRCULAR: return out_circular(p);
+		case IN_OUT_CIRCULAR: return in_out_circular(p);
+		case IN_EXPONENTIAL: return in_exponential(p);
+		case OUT_EXPONENTIAL: return out_exponential(p);
+		case IN_OUT_EXPONENTIAL: return in_out_exponential(p);
+		case IN_ELASTIC: return in_elastic(p);
+		case OUT_ELASTIC: return out_elastic(p);
+		case IN_OUT_ELASTIC: return in_out_elastic(p);
+		case IN_BACK: return in_back(p);
+		case OUT_BACK: return out_back(p);
+		case IN_OUT_BACK: return in_out_back(p);
+		case IN_BOUNCE: return in_bounce(p);
+		case OUT_BOUNCE: return out_bounce(p);
+		case IN_OUT_BOUNCE: return in_out_bounce(p);
+		default: return detail::evaluate_custom(f, p);
+	}
+#endif
+}
+
+/// Evaluate an ease function chosen by enum at `count` progress values from `p`, writing results to `out`.
+/// Unknown enum values behave as `LINEAR`.
+template<typename T> void evaluate(function f, const T *p, T *out, size_t count) {
+#ifdef EASE_COMPACT
+	for (size_t i = 0; i < count; i++) {
+		out[i] = evaluate(f, p[i]);
+	}
+#else
+	function_ptr<T> ease_function_ptr = get<T>(f);
+	if (!ease_function_ptr) {
+		ease_function_ptr = linear;
+	}
+	for (size_t i = 0; i < count; i++) {
+		out[i] = ease_function_ptr(p[i]);
+	}
+#endif
+}
+
+namespace detail {
+	/// Ease function known at compile time, so loops calling it can be inlined and vectorized
+	template<typename T, function_ptr<T> F> struct static_function {
+		T operator()(T p) const {
+			return F(p);
+		}
+	};
+
+	/// Ease function chosen at runtime, evaluated through `evaluate`
+	template<typename T> struct dynamic_function {
+		function f;
+
+		T operator()(T p) const {
+			return evaluate(f, p);
+		}
+	};
+
+	template<typename T, int F, typename Body> bool visit_custom_at(function f, Body& body) {
+		if constexpr (is_custom_function<F>::value) {
+			if (f == F) {
+				body(static_function<T, custom_function<F>::template evaluate<T>>());
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/// Call `body` with a `static_function` for custom ease function `f`, or with a `dynamic_function` if there is none
+	template<typename T, typename Body, size_t... I> void visit_custom(function f, Body& body, std::index_sequence<I...>) {
+		if (!(visit_custom_at<T, first_custom_function + int(I)>(f, body) || ...)) {
+			body(dynamic_function<T> { f });
+		}
+	}
+
+	/// Call `body` with a callable object evaluating ease function `f`.
+	/// Builtin and custom functions are passed as `static_function`, so that `body` is instantiated once per function with the curve inlined into its loops.
+	/// Unknown functions, as well as all functions in compact mode, are passed as a `dynamic_function`.
+	template<typename T, typename Body> void visit_function(function f, Body&& body) {
+#ifdef EASE_COMPACT
+		body(dynamic_function<T> { f });
+#else
+		switch (f) {
+			case LINEAR: return body(static_function<T, linear<T>>());
+			case IN_QUADRATIC: return body(static_function<T, in_quadratic<T>>());
+			case OUT_QUADRATIC: return body(static_function<T, out_quadratic<T>>());
+			case IN_OUT_QUADRATIC: return body(static_function<T, in_out_quadratic<T>>());
+			case IN_CUBIC: return body(static_function<T, in_cubic<T>>());
+			case OUT_CUBIC: return body(static_function<T, out_cubic<T>>());
+			case IN_OUT_CUBIC: return body(static_function<T, in_out_cubic<T>>());
+			case IN_QUARTIC: return body(static_function<T, in_quartic<T>>());
+			case OUT_QUARTIC: return body(static_function<T, out_quartic<T>>());
+			case IN_OUT_QUARTIC: return body(static_function<T, in_out_quartic<T>>());
+			case IN_QUINTIC: return body(static_function<T, in_quintic<T>>());
+			case OUT_QUINTIC: return body(static_function<T, out_quintic<T>>());
+			case IN_OUT_QUINTIC: return body(static_function<T, in_out_quintic<T>>());
+			case IN_SINE: return body(static_function<T, in_sine<T>>());
+			case OUT_SINE: return body(static_function<T, out_sine<T>>());
+			case IN_OUT_SINE: return body(static_function<T, in_out_sine<T>>());
+			case IN_CIRCULAR: return body(static_function<T, in_circular<T>>());
+			case OUT_CIRCULAR: return body(static_function<T, out_circular<T>>());
+			case IN_OUT_CIRCULAR: return body(static_function<T, in_out_circular<T>>());
+			case IN_EXPONENTIAL: return body(static_function<T, in_exponential<T>>());
+			case OUT_EXPONENTIAL: return body(static_function<T, out_exponential<T>>());
+			case IN_OUT_EXPONENTIAL: return body(static_function<T, in_out_exponential<T>>());
+			case IN_ELASTIC: return body(static_function<T, in_elastic<T>>());
+			case OUT_ELASTIC: return body(static_function<T, out_elastic<T>>());
+			case IN_OUT_ELASTIC: return body(static_function<T, in_out_elastic<T>>());
+			case IN_BACK: return body(static_function<T, in_back<T>>());
+			case OUT_BACK: return body(static_function<T, out_back<T>>());
+			case IN_OUT_BACK: return body(static_function<T, in_out_back<T>>());
+			case IN_BOUNCE: return body(static_function<T, in_bounce<T>>());
+			case OUT_BOUNCE: return body(static_function<T, out_bounce<T>>());
+			case IN_OUT_BOUNCE: return body(static_function<T, in_out_bounce<T>>());
+			default: return visit_custom<T>(f, body, std::make_index_sequence<EASE_MAX_CUSTOM_FUNCTIONS>());
+		}
+#endif
+	}
+
+	/// Interpolate values that wrap around every `period` along the shortest path, with the eased amounts of `f` at progress `p`.
+	/// With `Wrap`, results are wrapped to `[0, period)`, otherwise they move continuously away from `from`.
+	template<bool Wrap, typename T> void interpolate_periodic(function f, const T *from, const T *to, const T *p, T *out, size_t count, T period) {
+		T inverse_period = 1 / period;
+		visit_function<T>(f, [&](auto curve) {
+			for (size_t i = 0; i < count; i++) {
+				T delta = to[i] - from[i];
+				delta -= period * detail::floor(delta * inverse_period + T(0.5));
+				T value = from[i] + curve(p[i]) * delta;
+				if constexpr (Wrap) {
+					value -= period * detail::floor(value * inverse_period);
+					// Tiny negative values round up to `period` above
+					value = value < period ? value : T(0);
+				}
+				out[i] = value;
+			}
+		});
+	}
+}
+
+/// Interpolate `count` angles in radians from `from` to `to` along the shortest path around the circle,
+/// with the eased amounts of `f` at progress `p`, writing results to `out`.
+/// Results move continuously from `from`, so they may leave the `[-pi, pi]` range.
+/// Curve evaluation is fused into the interpolation loop and instantiated per builtin and custom function, so compilers can vectorize it.
+/// Piecewise functions like `IN_OUT_CUBIC` and `OUT_BOUNCE` only vectorize when floating point operations may be speculated, like with `-fno-trapping-math`.
+template<typename T> void interpolate_angles(function f, const T *from, const T *to, const T *p, T *out, size_t count) {
+	detail::interpolate_periodic<false>(f, from, to, p, out, count, 2 * detail::pi<T>());
+}
+
+/// Interpolate `count` hues from `from` to `to` along the shortest path around the color wheel,
+/// with the eased amounts of `f` at progress `p`, writing results wrapped to `[0, period)` to `out`.
+/// Use a `period` of 1 for normalized hues or 360 for degrees.
+/// Curve evaluation is fused into the interpolation loop like in `interpolate_angles`.
+template<typename T> void interpolate_hues(function f, const T *from, const T *to, const T *p, T *out, size_t count, T period = 1) {
+	detail::interpolate_periodic<true>(f, from, to, p, out, count, period);
+}
+
 /// Get the function pointer for an ease function using its name.
 /// Supports any casing, as well as whitespace, `_` and `-`, so that "IN_CUBIC" is the same as "InCubic" or "in cubic".
+/// Custom ease functions are matched by their `name`, ignoring case.
 /// Returns `nullptr` for unknown names.
 template<typename T> function_ptr<T> get(std::string_view name) {
+	std::string_view full_name = name;
 	if (detail::equals_ignore_case(name, "linear")) {
 		return linear;
 	}
@@ -445,7 +903,362 @@ template<typename T> function_ptr<T> get(std::string_view name) {
 		else if (detail::equals_ignore_case(name, "back")) return out_back;
 		else if (detail::equals_ignore_case(name, "bounce")) return out_bounce;
 	}
-	return nullptr;
+	return detail::get_custom<T>(full_name, std::make_index_sequence<EASE_MAX_CUSTOM_FUNCTIONS>());
+}
+
+/// Closed interval of values
+template<typename T> struct interval {
+	T min;
+	T max;
+};
+
+namespace detail {
+	/// Non-owning view of the critical points of an ease function
+	struct critical_points_view {
+		const double *data;
+		int size;
+	};
+
+	// Interior extrema in (0, 1) of non-monotone ease functions.
+	// The `in_out` and `out` variants are derived from the `in` ones by mirroring.
+	// Elastic extrema are the solutions of tan(13pi/2*x) = -(13pi/2)/(10*ln(2)).
+	inline constexpr double in_back_extremum = 0.5295728215786106;
+	inline constexpr double in_back_critical[] = { in_back_extremum };
+	inline constexpr double out_back_critical[] = { 1 - in_back_extremum };
+	inline constexpr double in_out_back_critical[] = { in_back_extremum / 2, 1 - in_back_extremum / 2 };
+
+	inline constexpr double in_elastic_critical[] = {
+		0.09294806481400233, 0.2467942186601562, 0.40064037250631,
+		0.5544865263524639, 0.7083326801986177, 0.8621788340447715,
+	};
+	inline constexpr double out_elastic_critical[] = {
+		0.13782116595522842, 0.29166731980138216, 0.44551347364753613,
+		0.5993596274936897, 0.7532057813398434, 0.9070519351859974,
+	};
+	inline constexpr double in_out_elastic_critical[] = {
+		in_elastic_critical[0] / 2, in_elastic_critical[1] / 2, in_elastic_critical[2] / 2,
+		in_elastic_critical[3] / 2, in_elastic_critical[4] / 2, in_elastic_critical[5] / 2,
+		(out_elastic_critical[0] + 1) / 2, (out_elastic_critical[1] + 1) / 2, (out_elastic_critical[2] + 1) / 2,
+		(out_elastic_critical[3] + 1) / 2, (out_elastic_critical[4] + 1) / 2, (out_elastic_critical[5] + 1) / 2,
+	};
+
+	// Bounce extrema are the joints between parabolas and the parabolas' vertices
+	inline constexpr double out_bounce_critical[] = {
+		4 / 11.0, (99 / 10.0) / (2 * 363 / 40.0),
+		8 / 11.0, (35442 / 1805.0) / (2 * 4356 / 361.0),
+		9 / 10.0, (513 / 25.0) / (2 * 54 / 5.0),
+	};
+	inline constexpr double in_bounce_critical[] = {
+		1 - out_bounce_critical[5], 1 - out_bounce_critical[4], 1 - out_bounce_critical[3],
+		1 - out_bounce_critical[2], 1 - out_bounce_critical[1], 1 - out_bounce_critical[0],
+	};
+	inline constexpr double in_out_bounce_critical[] = {
+		in_bounce_critical[0] / 2, in_bounce_critical[1] / 2, in_bounce_critical[2] / 2,
+		in_bounce_critical[3] / 2, in_bounce_critical[4] / 2, in_bounce_critical[5] / 2,
+		0.5,
+		(out_bounce_critical[0] + 1) / 2, (out_bounce_critical[1] + 1) / 2, (out_bounce_critical[2] + 1) / 2,
+		(out_bounce_critical[3] + 1) / 2, (out_bounce_critical[4] + 1) / 2, (out_bounce_critical[5] + 1) / 2,
+	};
+
+	template<size_t N> constexpr critical_points_view make_critical_points_view(const double (&points)[N]) {
+		return { points, int(N) };
+	}
+
+	template<int F> constexpr critical_points_view custom_critical_points() {
+		if constexpr (has_custom_critical_points<F>::value) {
+			return make_critical_points_view(custom_function<F>::critical_points);
+		}
+		else {
+			return { nullptr, 0 };
+		}
+	}
+
+	template<typename Dummy, typename Indices = std::make_index_sequence<EASE_MAX_CUSTOM_FUNCTIONS>> struct custom_critical_points_table;
+	template<typename Dummy, size_t... I> struct custom_critical_points_table<Dummy, std::index_sequence<I...>> {
+		static constexpr critical_points_view views[] = { custom_critical_points<first_custom_function + int(I)>()... };
+	};
+
+	/// Get the interior extrema of an ease function, in increasing order.
+	/// Monotone functions have none.
+	/// This is a template so that custom ease functions declared after this file are visible.
+	template<typename Dummy = void> constexpr critical_points_view critical_points(function f) {
+		switch (f) {
+			case IN_ELASTIC: return make_critical_points_view(in_elastic_critical);
+			case OUT_ELASTIC: return make_critical_points_view(out_elastic_critical);
+			case IN_OUT_ELASTIC: return make_critical_points_view(in_out_elastic_critical);
+			case IN_BACK: return make_critical_points_view(in_back_critical);
+			case OUT_BACK: return make_critical_points_view(out_back_critical);
+			case IN_OUT_BACK: return make_critical_points_view(in_out_back_critical);
+			case IN_BOUNCE: return make_critical_points_view(in_bounce_critical);
+			case OUT_BOUNCE: return make_critical_points_view(out_bounce_critical);
+			case IN_OUT_BOUNCE: return make_critical_points_view(in_out_bounce_critical);
+			default: {
+				int index = f - first_custom_function;
+				return index >= 0 && index < EASE_MAX_CUSTOM_FUNCTIONS ? custom_critical_points_table<Dummy>::views[index] : critical_points_view { nullptr, 0 };
+			}
+		}
+	}
+}
+
+/// Get the range of values an ease function reaches for progress in `[begin, end]`.
+/// The window is clamped to `[0, 1]` and may be given in any order.
+/// Bounds are computed from the window endpoints and the function's known extrema,
+/// so they are exact for overshooting functions like `OUT_BACK`, `OUT_ELASTIC` and `OUT_BOUNCE`.
+/// Unknown enum values are treated as `LINEAR`.
+template<typename T> interval<T> bounds(function f, T begin, T end) {
+	if (end < begin) {
+		T tmp = begin;
+		begin = end;
+		end = tmp;
+	}
+	begin = begin < 0 ? 0 : (begin > 1 ? 1 : begin);
+	end = end < 0 ? 0 : (end > 1 ? 1 : end);
+
+	T first = evaluate(f, begin), last = evaluate(f, end);
+	interval<T> result = first < last ? interval<T>{ first, last } : interval<T>{ last, first };
+	detail::critical_points_view points = detail::critical_points(f);
+	for (int i = 0; i < points.size; i++) {
+		T p = T(points.data[i]);
+		if (p <= begin) {
+			continue;
+		}
+		else if (p >= end) {
+			break;
+		}
+		T value = evaluate(f, p);
+		if (value < result.min) result.min = value;
+		if (value > result.max) result.max = value;
+	}
+	return result;
+}
+
+/// Get the ranges of values reached by `count` ease functions over their respective progress windows `[begin[i], end[i]]`.
+template<typename T> void bounds(const function *f, const T *begin, const T *end, interval<T> *out, size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		out[i] = bounds(f[i], begin[i], end[i]);
+	}
+}
+
+/// Maximum number of times any ease function crosses a given value for progress in `[0, 1]`
+inline constexpr int max_crossings = 16;
+
+/// Find the progress values in `[0, 1]` where ease function `f` crosses `value`, writing them to `out` in increasing order.
+/// `out` must have room for `max_crossings` values.
+/// Non-monotone functions like `OUT_BACK` and `OUT_ELASTIC` may cross a value several times, and all crossings are found.
+/// Crossings are solved by bisection in each monotone piece between the function's known extrema, so they are exact up to `T` precision.
+/// Values within a few rounding errors of a piece's end cross exactly there, so values touched at joints, like 1 for `OUT_BOUNCE`, are found once per joint.
+/// Returns the number of crossings found.
+/// Unknown enum values are treated as `LINEAR`.
+template<typename T> int crossings(function f, T value, T *out) {
+	detail::critical_points_view points = detail::critical_points(f);
+	// Critical points are stored as `double`, so piece ends are only exact up to `double` precision
+	constexpr T tolerance = 16 * (detail::epsilon<T>() > T(detail::epsilon<double>()) ? detail::epsilon<T>() : T(detail::epsilon<double>()));
+	auto touches = [value](T piece_value) {
+		return piece_value - value <= tolerance && value - piece_value <= tolerance;
+	};
+	int count = 0;
+	T begin = 0, begin_value = evaluate(f, begin);
+	for (int i = 0; i <= points.size; i++) {
+		T end = i < points.size ? T(points.data[i]) : T(1);
+		T end_value = evaluate(f, end);
+		bool rising = begin_value <= end_value;
+		T low_value = rising ? begin_value : end_value, high_value = rising ? end_value : begin_value;
+		if (touches(begin_value)) {
+			// Crossings at the start of a piece were already found as the end of the previous one
+			if (i == 0) {
+				out[count++] = begin;
+			}
+		}
+		else if (touches(end_value)) {
+			out[count++] = end;
+		}
+		else if (value > low_value && value < high_value) {
+			// Bisect for the first progress where the function reaches `value` in the monotone piece
+			T low = begin, high = end;
+			for (int iteration = 0; iteration < 200; iteration++) {
+				T middle = low + (high - low) / 2;
+				if (middle <= low || middle >= high) {
+					break;
+				}
+				T middle_value = evaluate(f, middle);
+				if (rising ? middle_value < value : middle_value > value) {
+					low = middle;
+				}
+				else {
+					high = middle;
+				}
+			}
+			out[count++] = evaluate(f, low) == value ? low : high;
+		}
+		begin = end;
+		begin_value = end_value;
+	}
+	return count;
+}
+
+/// Static properties of an ease function over progress in `[0, 1]`
+struct function_traits {
+	/// Minimum output value
+	double min;
+	/// Maximum output value
+	double max;
+	/// How far the output goes outside `[0, 1]`
+	double overshoot;
+	/// Whether the output never decreases as progress increases
+	bool monotone;
+	/// Whether the function can be evaluated in constant expressions
+	bool constexpr_evaluable;
+	/// Whether the function is point symmetric around `(0.5, 0.5)`, that is `f(1 - x) = 1 - f(x)`
+	bool symmetric;
+	/// Approximate relative evaluation cost, with `LINEAR` being 1
+	int cost;
+};
+
+/// Traits of all ease functions, indexed by the `function` enum
+inline constexpr function_traits traits_table[] = {
+	/* LINEAR */ { 0, 1, 0, true, true, true, 1 },
+	/* IN_QUADRATIC */ { 0, 1, 0, true, true, false, 2 },
+	/* OUT_QUADRATIC */ { 0, 1, 0, true, true, false, 2 },
+	/* IN_OUT_QUADRATIC */ { 0, 1, 0, true, true, true, 3 },
+	/* IN_CUBIC */ { 0, 1, 0, true, true, false, 3 },
+	/* OUT_CUBIC */ { 0, 1, 0, true, true, false, 3 },
+	/* IN_OUT_CUBIC */ { 0, 1, 0, true, true, true, 4 },
+	/* IN_QUARTIC */ { 0, 1, 0, true, true, false, 4 },
+	/* OUT_QUARTIC */ { 0, 1, 0, true, true, false, 4 },
+	/* IN_OUT_QUARTIC */ { 0, 1, 0, true, true, true, 5 },
+	/* IN_QUINTIC */ { 0, 1, 0, true, true, false, 5 },
+	/* OUT_QUINTIC */ { 0, 1, 0, true, true, false, 5 },
+	/* IN_OUT_QUINTIC */ { 0, 1, 0, true, true, true, 6 },
+	/* IN_SINE */ { 0, 1, 0, true, false, false, 20 },
+	/* OUT_SINE */ { 0, 1, 0, true, false, false, 20 },
+	/* IN_OUT_SINE */ { 0, 1, 0, true, false, true, 20 },
+	/* IN_CIRCULAR */ { 0, 1, 0, true, false, false, 12 },
+	/* OUT_CIRCULAR */ { 0, 1, 0, true, false, false, 12 },
+	/* IN_OUT_CIRCULAR */ { 0, 1, 0, true, false, true, 13 },
+	/* IN_EXPONENTIAL */ { 0, 1, 0, true, true, false, 25 },
+	/* OUT_EXPONENTIAL */ { 0, 1, 0, true, true, false, 25 },
+	/* IN_OUT_EXPONENTIAL */ { 0, 1, 0, true, true, true, 26 },
+	/* IN_ELASTIC */ { -0.3642812779412454, 1, 0.3642812779412454, false, false, false, 45 },
+	/* OUT_ELASTIC */ { 0, 1.3642812779412454, 0.3642812779412454, false, false, false, 45 },
+	/* IN_OUT_ELASTIC */ { -0.1821406389706227, 1.1821406389706227, 0.1821406389706227, false, false, true, 46 },
+	/* IN_BACK */ { -0.3787716596057283, 1, 0.3787716596057283, false, false, false, 22 },
+	/* OUT_BACK */ { 0, 1.3787716596057283, 0.3787716596057283, false, false, false, 22 },
+	/* IN_OUT_BACK */ { -0.18938582980286414, 1.1893858298028641, 0.18938582980286414, false, false, true, 23 },
+	/* IN_BOUNCE */ { 0, 1, 0, false, true, false, 7 },
+	/* OUT_BOUNCE */ { 0, 1, 0, false, true, false, 6 },
+	/* IN_OUT_BOUNCE */ { 0, 1, 0, false, true, true, 8 },
+};
+static_assert(sizeof(traits_table) / sizeof(traits_table[0]) == function_count, "traits_table must have one entry per ease function");
+
+namespace detail {
+	template<int F> constexpr const function_traits *custom_traits() {
+		if constexpr (is_custom_function<F>::value) {
+			return &custom_function<F>::traits;
+		}
+		else {
+			return nullptr;
+		}
+	}
+
+	template<typename Dummy, typename Indices = std::make_index_sequence<EASE_MAX_CUSTOM_FUNCTIONS>> struct custom_traits_table;
+	template<typename Dummy, size_t... I> struct custom_traits_table<Dummy, std::index_sequence<I...>> {
+		static constexpr const function_traits *pointers[] = { custom_traits<first_custom_function + int(I)>()... };
+	};
+}
+
+/// Get the static properties of an ease function, including custom ease functions.
+/// Unknown enum values return the traits of `LINEAR`.
+/// This is a template so that custom ease functions declared after this file are visible.
+template<typename Dummy = void> constexpr const function_traits& traits(function f) {
+	if (f >= 0 && f < function_count) {
+		return traits_table[f];
+	}
+	int index = f - first_custom_function;
+	if (index >= 0 && index < EASE_MAX_CUSTOM_FUNCTIONS && detail::custom_traits_table<Dummy>::pointers[index]) {
+		return *detail::custom_traits_table<Dummy>::pointers[index];
+	}
+	return traits_table[LINEAR];
+}
+
+namespace detail {
+	/// Normalized fling curve for a fling whose velocity decays by e^`decay` until it stops
+	template<typename T> T fling_curve(T decay, T p) {
+		if (!(decay > 0)) {
+			return p;
+		}
+		return (1 - exp(-decay * p)) / (1 - exp(-decay));
+	}
+}
+
+/// Fling (inertial scroll) motion, with velocity decaying exponentially by friction until it drops below a stop speed.
+/// Velocity is v(t) = v0*e^(-friction*t) and position is x(t) = v0/friction*(1 - e^(-friction*t)),
+/// so the stop time and landing position are known in closed form without stepping a simulation.
+template<typename T> struct fling {
+	/// Signed initial velocity, in units per second
+	T initial_velocity;
+	/// Exponential decay rate of velocity, per second. Must be positive.
+	T friction;
+	/// Speed below which the fling stops. Must be positive.
+	T stop_speed;
+
+	/// Create a fling that stops at `distance` from its start, useful for snapping the landing point
+	static fling with_stop_position(T distance, T friction, T stop_speed) {
+		T speed = (distance < 0 ? -distance : distance) * friction + stop_speed;
+		return { distance < 0 ? -speed : speed, friction, stop_speed };
+	}
+
+	/// Time when the fling stops
+	T stop_time() const {
+		T speed = initial_velocity < 0 ? -initial_velocity : initial_velocity;
+		return speed > stop_speed ? detail::log(speed / stop_speed) / friction : 0;
+	}
+
+	/// Distance traveled until the fling stops
+	T stop_position() const {
+		return position(stop_time());
+	}
+
+	/// Distance traveled at time `t`
+	T position(T t) const {
+		T stop = stop_time();
+		t = t < 0 ? 0 : (t > stop ? stop : t);
+		return initial_velocity / friction * (1 - detail::exp(-friction * t));
+	}
+
+	/// Velocity at time `t`, which is zero after the fling stops
+	T velocity(T t) const {
+		if (t < 0 || t >= stop_time()) {
+			return 0;
+		}
+		return initial_velocity * detail::exp(-friction * t);
+	}
+
+	/// Normalized fling curve, mapping progress in `[0, 1]` over the stop time to the fraction of the stop position traveled.
+	/// This makes flings usable as an ease function for tweens from the start to the landing position.
+	T operator()(T p) const {
+		return detail::fling_curve(friction * stop_time(), p);
+	}
+};
+
+/// Get the positions of `count` flings at time `t`
+template<typename T> void positions(const fling<T> *flings, size_t count, T t, T *out) {
+	for (size_t i = 0; i < count; i++) {
+		out[i] = flings[i].position(t);
+	}
+}
+
+/// Get the velocities of `count` flings at time `t`
+template<typename T> void velocities(const fling<T> *flings, size_t count, T t, T *out) {
+	for (size_t i = 0; i < count; i++) {
+		out[i] = flings[i].velocity(t);
+	}
+}
+
+/// Get the landing positions of `count` flings
+template<typename T> void stop_positions(const fling<T> *flings, size_t count, T *out) {
+	for (size_t i = 0; i < count; i++) {
+		out[i] = flings[i].stop_position();
+	}
 }
 
 }
@@ -0,0 +1,537 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ease.hpp"
+#include "ease_tween.hpp"
+
+
+namespace ease {
+
+// Asynchronous batch easing with senders and receivers, following the shape of P2300 (`std::execution`).
+//
+// - A scheduler has `schedule()`, returning a sender that completes on the scheduler's execution context.
+// - A sender has `connect(receiver)`, returning an operation state.
+// - An operation state has `start()`. It is not movable and must stay alive until the receiver is completed.
+// - A receiver has `set_value(...)`, `set_error(std::exception_ptr)` and `set_stopped()`.
+//
+// The senders returned here split work in chunks, schedule each chunk on the given scheduler and complete with `set_value()` after all chunks finished.
+// Chunk operation states live in a single allocation made in `connect`, so there are no allocations per chunk.
+// Use `then` to run a follow-up stage after one of them, like presenting a frame after `update_async`.
+
+namespace detail {
+	/// Converts to the result of calling `f`, for constructing non-movable types in place with guaranteed copy elision
+	template<typename F> struct emplacer {
+		F f;
+
+		operator decltype(std::declval<F&>()())() {
+			return f();
+		}
+	};
+	template<typename F> emplacer(F) -> emplacer<F>;
+
+	/// Operation state that runs `work(begin, end)` for each chunk of `[0, count)` on a scheduler, then `done()`, then completes `receiver`
+	template<typename Scheduler, typename Work, typename Done, typename Receiver> class bulk_operation {
+		struct chunk_receiver {
+			bulk_operation *operation;
+			size_t index;
+
+			void set_value() {
+				if (!operation->failed.load(std::memory_order_relaxed)) {
+					size_t begin = index * operation->chunk_size;
+					size_t end = std::min(begin + operation->chunk_size, operation->count);
+					try {
+						operation->work(begin, end);
+					}
+					catch (...) {
+						operation->fail(std::current_exception());
+					}
+				}
+				operation->chunk_finished();
+			}
+
+			void set_error(std::exception_ptr error) {
+				operation->fail(std::move(error));
+				operation->chunk_finished();
+			}
+
+			template<typename Error> void set_error(Error&& error) {
+				set_error(std::make_exception_ptr(std::forward<Error>(error)));
+			}
+
+			void set_stopped() {
+				operation->stopped.store(true, std::memory_order_relaxed);
+				operation->failed.store(true, std::memory_order_relaxed);
+				operation->chunk_finished();
+			}
+		};
+
+		using chunk_operation = decltype(std::declval<Scheduler&>().schedule().connect(std::declval<chunk_receiver>()));
+
+	public:
+		bulk_operation(Scheduler scheduler, Work work, Done done, size_t count, size_t chunk_size, Receiver receiver)
+			: scheduler(std::move(scheduler))
+			, work(std::move(work))
+			, done(std::move(done))
+			, receiver(std::move(receiver))
+			, count(count)
+			, chunk_size(chunk_size > 0 ? chunk_size : 1)
+			, chunk_count((count + this->chunk_size - 1) / this->chunk_size)
+			, remaining(chunk_count)
+			, chunks(new std::optional<chunk_operation>[chunk_count])
+		{
+			for (size_t i = 0; i < chunk_count; i++) {
+				chunks[i].emplace(emplacer{ [this, i] { return this->scheduler.schedule().connect(chunk_receiver{ this, i }); } });
+			}
+		}
+
+		bulk_operation(const bulk_operation&) = delete;
+		bulk_operation& operator=(const bulk_operation&) = delete;
+
+		void start() {
+			if (chunk_count == 0) {
+				complete();
+				return;
+			}
+			// The last chunk may complete the receiver, which may destroy this operation before `start` returns,
+			// so nothing on `this` is touched after starting it
+			size_t operation_count = chunk_count;
+			std::optional<chunk_operation> *operations = chunks.get();
+			for (size_t i = 0; i < operation_count; i++) {
+				operations[i]->start();
+			}
+		}
+
+	private:
+		Scheduler scheduler;
+		Work work;
+		Done done;
+		Receiver receiver;
+		size_t count;
+		size_t chunk_size;
+		size_t chunk_count;
+		std::atomic<size_t> remaining;
+		std::atomic<bool> failed { false };
+		std::atomic<bool> stopped { false };
+		std::atomic<bool> has_error { false };
+		std::exception_ptr error;
+		std::unique_ptr<std::optional<chunk_operation>[]> chunks;
+
+		void fail(std::exception_ptr exception) {
+			failed.store(true, std::memory_order_relaxed);
+			if (!has_error.exchange(true)) {
+				error = std::move(exception);
+			}
+		}
+
+		void chunk_finished() {
+			if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				complete();
+			}
+		}
+
+		void complete() {
+			if (has_error.load()) {
+				std::move(receiver).set_error(std::move(error));
+			}
+			else if (stopped.load()) {
+				std::move(receiver).set_stopped();
+			}
+			else {
+				try {
+					done();
+				}
+				catch (...) {
+					std::move(receiver).set_error(std::current_exception());
+					return;
+				}
+				std::move(receiver).set_value();
+			}
+		}
+	};
+
+	/// Sender for `bulk_operation`
+	template<typename Scheduler, typename Work, typename Done> class bulk_sender {
+	public:
+		template<template<typename...> class Tuple, template<typename...> class Variant> using value_types = Variant<Tuple<>>;
+		template<template<typename...> class Variant> using error_types = Variant<std::exception_ptr>;
+		static constexpr bool sends_done = true;
+
+		bulk_sender(Scheduler scheduler, Work work, Done done, size_t count, size_t chunk_size)
+			: scheduler(std::move(scheduler))
+			, work(std::move(work))
+			, done(std::move(done))
+			, count(count)
+			, chunk_size(chunk_size)
+		{
+		}
+
+		template<typename Receiver> bulk_operation<Scheduler, Work, Done, Receiver> connect(Receiver receiver) const {
+			return { scheduler, work, done, count, chunk_size, std::move(receiver) };
+		}
+
+	private:
+		Scheduler scheduler;
+		Work work;
+		Done done;
+		size_t count;
+		size_t chunk_size;
+	};
+
+	template<typename Scheduler, typename Work, typename Done> bulk_sender<Scheduler, Work, Done> make_bulk_sender(Scheduler scheduler, Work work, Done done, size_t count, size_t chunk_size) {
+		return { std::move(scheduler), std::move(work), std::move(done), count, chunk_size };
+	}
+
+	/// Receiver that calls `f` when the sender it is connected to completes with no values, then completes `receiver` with its result
+	template<typename F, typename Receiver> struct then_receiver {
+		F f;
+		Receiver receiver;
+
+		void set_value() {
+			using result = std::invoke_result_t<F&>;
+			if constexpr (std::is_void_v<result>) {
+				try {
+					f();
+				}
+				catch (...) {
+					std::move(receiver).set_error(std::current_exception());
+					return;
+				}
+				std::move(receiver).set_value();
+			}
+			else {
+				std::optional<result> value;
+				try {
+					value.emplace(f());
+				}
+				catch (...) {
+					std::move(receiver).set_error(std::current_exception());
+					return;
+				}
+				std::move(receiver).set_value(std::move(*value));
+			}
+		}
+
+		template<typename Error> void set_error(Error&& error) {
+			std::move(receiver).set_error(std::forward<Error>(error));
+		}
+
+		void set_stopped() {
+			std::move(receiver).set_stopped();
+		}
+	};
+
+	/// Operation state for `then_sender`, wrapping the operation state of the first stage
+	template<typename Sender, typename F, typename Receiver> class then_operation {
+	public:
+		then_operation(const Sender& sender, F f, Receiver receiver)
+			: operation(sender.connect(then_receiver<F, Receiver> { std::move(f), std::move(receiver) }))
+		{
+		}
+
+		then_operation(const then_operation&) = delete;
+		then_operation& operator=(const then_operation&) = delete;
+
+		void start() {
+			operation.start();
+		}
+
+	private:
+		decltype(std::declval<const Sender&>().connect(std::declval<then_receiver<F, Receiver>>())) operation;
+	};
+
+	/// Sender returned by `then`
+	template<typename Sender, typename F> class then_sender {
+		using result = std::invoke_result_t<F&>;
+
+	public:
+		template<template<typename...> class Tuple, template<typename...> class Variant> using value_types = std::conditional_t<std::is_void_v<result>, Variant<Tuple<>>, Variant<Tuple<result>>>;
+		template<template<typename...> class Variant> using error_types = Variant<std::exception_ptr>;
+		static constexpr bool sends_done = Sender::sends_done;
+
+		then_sender(Sender sender, F f)
+			: sender(std::move(sender))
+			, f(std::move(f))
+		{
+		}
+
+		template<typename Receiver> then_operation<Sender, F, Receiver> connect(Receiver receiver) const {
+			return { sender, f, std::move(receiver) };
+		}
+
+	private:
+		Sender sender;
+		F f;
+	};
+}
+
+/// Returns a sender that calls `f()` on the execution context where `sender` completes, after it completes with no values,
+/// then completes with the result of `f`.
+/// Errors and stops of `sender` are forwarded without calling `f`, and exceptions thrown by `f` complete with `set_error`.
+/// Stages compose without allocations, since the operation state of `sender` is stored inline in the returned sender's operation state.
+template<typename Sender, typename F> detail::then_sender<Sender, F> then(Sender sender, F f) {
+	return { std::move(sender), std::move(f) };
+}
+
+/// Scheduler that runs work immediately on the thread that starts it
+struct inline_scheduler {
+	template<typename Receiver> struct operation {
+		Receiver receiver;
+
+		void start() {
+			std::move(receiver).set_value();
+		}
+	};
+
+	struct sender {
+		template<template<typename...> class Tuple, template<typename...> class Variant> using value_types = Variant<Tuple<>>;
+		template<template<typename...> class Variant> using error_types = Variant<>;
+		static constexpr bool sends_done = false;
+
+		template<typename Receiver> operation<Receiver> connect(Receiver receiver) const {
+			return { std::move(receiver) };
+		}
+	};
+
+	sender schedule() const {
+		return {};
+	}
+};
+
+/// Returns a sender that evaluates ease function `f` at `count` progress values from `p` into `out`, in chunks of `chunk_size` scheduled on `scheduler`.
+/// `p` and `out` must stay valid until the sender completes.
+template<typename Scheduler, typename T> auto evaluate_async(Scheduler scheduler, function f, const T *p, T *out, size_t count, size_t chunk_size = 4096) {
+	return detail::make_bulk_sender(
+		std::move(scheduler),
+		[f, p, out](size_t begin, size_t end) {
+			evaluate(f, p + begin, out + begin, end - begin);
+		},
+		[] {},
+		count,
+		chunk_size
+	);
+}
+
+/// Returns a sender that advances all tweens in `pool` by `dt`, in chunks of about `chunk_size` tweens scheduled on `scheduler`.
+/// The changed index list and events are refreshed after all chunks finish, right before completing.
+/// `pool` must stay valid and must not be modified until the sender completes.
+template<typename Scheduler, typename T, typename Time> auto update_async(Scheduler scheduler, tween_pool<T, Time>& pool, Time dt, size_t chunk_size = 4096) {
+	size_t blocks_per_chunk = (chunk_size + 63) / 64;
+	return detail::make_bulk_sender(
+		std::move(scheduler),
+		[&pool, dt](size_t first_block, size_t last_block) {
+			pool.update_blocks(dt, first_block, last_block);
+		},
+		[&pool, dt] {
+			pool.finish_update(dt);
+		},
+		pool.block_count(),
+		blocks_per_chunk
+	);
+}
+
+/// Tween pool that computes the next frame's values on a background thread while the current frame is in use.
+/// Each `advance(dt)` presents the frame computed in the background and starts computing the one `dt` later,
+/// hiding animation cost from the critical path as long as the frame time is known one frame ahead.
+///
+/// Retargets are queued without waiting: when the next frame is presented, only the retargeted tweens are patched,
+/// restarting them from their value in the current frame.
+/// Adding and removing tweens waits for the frame in flight to finish.
+/// All methods must be called from the same thread.
+template<typename T, typename Time = T> class pipelined_tween_pool {
+public:
+	pipelined_tween_pool()
+		: worker([this] { run(); })
+	{
+	}
+
+	~pipelined_tween_pool() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			quit = true;
+		}
+		condition.notify_all();
+		worker.join();
+	}
+
+	pipelined_tween_pool(const pipelined_tween_pool&) = delete;
+	pipelined_tween_pool& operator=(const pipelined_tween_pool&) = delete;
+
+	/// Add a tween that eases from `from` to `to` in `duration` time units with `curve`.
+	/// It appears with value `from` in the next presented frame.
+	tween_id add(function curve, T from, T to, Time duration) {
+		wait();
+		tween_id id = pool.add(curve, from, to, duration);
+		resize_buffers();
+		patch(id);
+		return id;
+	}
+
+	/// Remove a tween, whose value becomes zero from the next presented frame on
+	void remove(tween_id id) {
+		wait();
+		if (pool.alive(id)) {
+			pool.remove(id);
+			patch(id);
+		}
+	}
+
+	/// Restart a tween from its value in the current frame towards `to` over `duration`.
+	/// Doesn't wait for the frame in flight: the tween is patched when the next frame is presented.
+	void retarget(tween_id id, T to, Time duration) {
+		retargets.push_back({ id, to, duration });
+	}
+
+	/// Present the frame computed in the background and start computing the one `dt` time units after it
+	void advance(Time dt) {
+		if (!frame_pending) {
+			launch(dt);
+		}
+		wait();
+		frame_pending = false;
+		for (const retarget_command& command : retargets) {
+			if (pool.alive(command.id)) {
+				pool.retarget(command.id, front_values[command.id], command.to, command.duration, frame_dt);
+				patch(command.id);
+			}
+		}
+		retargets.clear();
+		unlist();
+		std::swap(front_values, back_values);
+		std::swap(front_changed, back_changed);
+		launch(dt);
+	}
+
+	/// Values of all tweens in the current frame, indexed by identifier
+	const T *data() const {
+		return front_values.data();
+	}
+
+	/// Value of a tween in the current frame
+	T value(tween_id id) const {
+		return front_values[id];
+	}
+
+	/// Identifiers of tweens whose value changed in the current frame, each listed once.
+	/// Tweens patched by retargets, additions or removals come after the ones changed by the update, so they may be out of order.
+	const std::vector<tween_id>& changed() const {
+		return front_changed;
+	}
+
+	/// Whether `id` refers to a tween currently in the pool
+	bool alive(tween_id id) {
+		wait();
+		return pool.alive(id);
+	}
+
+private:
+	struct retarget_command {
+		tween_id id;
+		T to;
+		Time duration;
+	};
+
+	tween_pool<T, Time> pool;
+	std::vector<T> front_values;
+	std::vector<T> back_values;
+	std::vector<tween_id> front_changed;
+	std::vector<tween_id> back_changed;
+	/// One bit per tween listed in `back_changed`, so tweens patched more than once or already changed by the update are listed once
+	std::vector<uint64_t> listed_bits;
+	/// Whether `listed_bits` holds the tweens in `back_changed`, which is only filled in by the first patch of a frame
+	bool listed = false;
+	std::vector<retarget_command> retargets;
+	Time frame_dt = 0;
+	/// Whether a frame was launched and not presented yet
+	bool frame_pending = false;
+	/// Whether the worker may still be computing the pending frame
+	bool in_flight = false;
+
+	std::mutex mutex;
+	std::condition_variable condition;
+	bool job_pending = false;
+	bool quit = false;
+	std::thread worker;
+
+	void launch(Time dt) {
+		unlist();
+		frame_dt = dt;
+		frame_pending = true;
+		in_flight = true;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			job_pending = true;
+		}
+		condition.notify_all();
+	}
+
+	void wait() {
+		if (in_flight) {
+			std::unique_lock<std::mutex> lock(mutex);
+			condition.wait(lock, [this] { return !job_pending; });
+			in_flight = false;
+		}
+	}
+
+	void resize_buffers() {
+		front_values.resize(pool.capacity());
+		back_values.resize(pool.capacity());
+		listed_bits.resize(detail::bit_words(pool.capacity()));
+	}
+
+	/// Copy a tween's value to the frame that will be presented next, listing it as changed unless it already is
+	void patch(tween_id id) {
+		if (!listed) {
+			for (tween_id changed : back_changed) {
+				listed_bits[changed / 64] |= uint64_t(1) << (changed % 64);
+			}
+			listed = true;
+		}
+		back_values[id] = pool.value(id);
+		uint64_t bit = uint64_t(1) << (id % 64);
+		if (!(listed_bits[id / 64] & bit)) {
+			listed_bits[id / 64] |= bit;
+			back_changed.push_back(id);
+		}
+	}
+
+	/// Clear `listed_bits` before `back_changed` is replaced
+	void unlist() {
+		if (listed) {
+			for (tween_id changed : back_changed) {
+				listed_bits[changed / 64] &= ~(uint64_t(1) << (changed % 64));
+			}
+			listed = false;
+		}
+	}
+
+	void run() {
+		std::unique_lock<std::mutex> lock(mutex);
+		while (true) {
+			condition.wait(lock, [this] { return job_pending || quit; });
+			if (quit) {
+				return;
+			}
+			lock.unlock();
+			pool.update(frame_dt);
+			back_values.assign(pool.data(), pool.data() + pool.capacity());
+			back_changed = pool.changed();
+			lock.lock();
+			job_pending = false;
+			condition.notify_all();
+		}
+	}
+};
+
+}
@@ -0,0 +1,290 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#include "ease.hpp"
+
+
+namespace ease {
+
+/// Piecewise quadratic approximation of an ease function over `N` uniform segments of `[0, 1]`.
+/// Each segment stores coefficients for y = (a*u + b)*u + c, where `u` is the local `[0, 1]` position inside the segment.
+/// Tables with 16 or 32 entries fit in SIMD registers, so batch evaluation indexes them with permutes instead of memory gathers.
+/// Useful for functions that are expensive and hard to approximate with a single polynomial, like elastic and bounce.
+template<int N> struct quadratic_table {
+	static_assert(N == 16 || N == 32, "quadratic_table supports 16 or 32 entries");
+
+	float a[N];
+	float b[N];
+	float c[N];
+
+	/// Build the table for ease function `f`, interpolating it exactly at both ends and in the middle of each segment
+	static quadratic_table build(function f) {
+		quadratic_table table;
+		for (int i = 0; i < N; i++) {
+			double y0 = evaluate(f, double(i) / N);
+			double ym = evaluate(f, (i + 0.5) / N);
+			double y1 = evaluate(f, double(i + 1) / N);
+			double a = 2 * (y1 - 2 * ym + y0);
+			table.a[i] = float(a);
+			table.b[i] = float(y1 - y0 - a);
+			table.c[i] = float(y0);
+		}
+		return table;
+	}
+
+	/// Evaluate the table at progress `p`, clamped to `[0, 1]`
+	float operator()(float p) const {
+		float x = (p < 0 ? 0 : (p > 1 ? 1 : p)) * N;
+		int i = int(x);
+		i = i < N - 1 ? i : N - 1;
+		float u = x - i;
+		return (a[i] * u + b[i]) * u + c[i];
+	}
+};
+
+namespace detail {
+#if defined(__AVX512F__)
+	/// Look up 16 lanes of a 16 or 32 entry table held in registers
+	template<int N> __m512 permute_table(const float *table, __m512i index) {
+		if constexpr (N == 16) {
+			return _mm512_permutexvar_ps(index, _mm512_loadu_ps(table));
+		}
+		else {
+			return _mm512_permutex2var_ps(_mm512_loadu_ps(table), index, _mm512_loadu_ps(table + 16));
+		}
+	}
+#elif defined(__AVX2__)
+	/// Look up 8 lanes of an 8 entry table held in one register, using only the low 3 bits of each index.
+	/// Larger tables call this once per 8 entries and pick each lane's result with blends on the higher index bits.
+	inline __m256 permute_table8(const float *table, __m256i index) {
+		return _mm256_permutevar8x32_ps(_mm256_loadu_ps(table), index);
+	}
+
+	/// Look up 8 lanes of a 16 or 32 entry table held in registers
+	template<int N> __m256 permute_table(const float *table, __m256i index) {
+		__m256 high8 = _mm256_castsi256_ps(_mm256_slli_epi32(index, 28));
+		__m256 low16 = _mm256_blendv_ps(permute_table8(table, index), permute_table8(table + 8, index), high8);
+		if constexpr (N == 16) {
+			return low16;
+		}
+		else {
+			__m256 high16 = _mm256_blendv_ps(permute_table8(table + 16, index), permute_table8(table + 24, index), high8);
+			return _mm256_blendv_ps(low16, high16, _mm256_castsi256_ps(_mm256_slli_epi32(index, 27)));
+		}
+	}
+#endif
+}
+
+/// Evaluate a quadratic table at `count` progress values from `p`, writing results to `out`.
+/// Uses register permutes with AVX-512 or AVX2 when the compiler targets them, and falls back to table lookups in memory otherwise.
+template<int N> void evaluate(const quadratic_table<N>& table, const float *p, float *out, size_t count) {
+	size_t i = 0;
+#if defined(__AVX512F__)
+	const __m512 zero = _mm512_setzero_ps(), one = _mm512_set1_ps(1), size = _mm512_set1_ps(N);
+	const __m512i last = _mm512_set1_epi32(N - 1);
+	for (; i + 16 <= count; i += 16) {
+		__m512 x = _mm512_mul_ps(_mm512_min_ps(_mm512_max_ps(_mm512_loadu_ps(p + i), zero), one), size);
+		__m512i index = _mm512_min_epi32(_mm512_cvttps_epi32(x), last);
+		__m512 u = _mm512_sub_ps(x, _mm512_cvtepi32_ps(index));
+		__m512 a = detail::permute_table<N>(table.a, index);
+		__m512 b = detail::permute_table<N>(table.b, index);
+		__m512 c = detail::permute_table<N>(table.c, index);
+		_mm512_storeu_ps(out + i, _mm512_add_ps(_mm512_mul_ps(_mm512_add_ps(_mm512_mul_ps(a, u), b), u), c));
+	}
+#elif defined(__AVX2__)
+	const __m256 zero = _mm256_setzero_ps(), one = _mm256_set1_ps(1), size = _mm256_set1_ps(N);
+	const __m256i last = _mm256_set1_epi32(N - 1);
+	for (; i + 8 <= count; i += 8) {
+		__m256 x = _mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(p + i), zero), one), size);
+		__m256i index = _mm256_min_epi32(_mm256_cvttps_epi32(x), last);
+		__m256 u = _mm256_sub_ps(x, _mm256_cvtepi32_ps(index));
+		__m256 a = detail::permute_table<N>(table.a, index);
+		__m256 b = detail::permute_table<N>(table.b, index);
+		__m256 c = detail::permute_table<N>(table.c, index);
+		_mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(a, u), b), u), c));
+	}
+#endif
+	for (; i < count; i++) {
+		out[i] = table(p[i]);
+	}
+}
+
+/// Linearly interpolated table of an ease function with knot density following the function's curvature.
+/// `[0, 1]` is split into `segments` uniform segments, each holding its own number of uniformly spaced knots,
+/// so lookups are a branch-free two-level index instead of a search, while flat regions use few entries and steep ones use many.
+/// Useful for functions like `IN_EXPONENTIAL` or `IN_OUT_ELASTIC`, where a uniform table wastes entries on flat parts.
+template<typename T> class adaptive_table {
+public:
+	/// Number of top level segments
+	static constexpr int segments = 16;
+
+	/// Build a table for ease function `f` whose interpolation error is at most `tolerance`.
+	/// Each segment doubles its knot count until the error measured between knots is within tolerance or it reaches `max_knots_per_segment`,
+	/// which bounds the size for discontinuous functions.
+	static adaptive_table build(function f, double tolerance, int max_knots_per_segment = 1024) {
+		adaptive_table table;
+		for (int s = 0; s < segments; s++) {
+			double begin = double(s) / segments;
+			int count = 1;
+			while (count < max_knots_per_segment && segment_error(f, begin, count) > tolerance) {
+				count *= 2;
+			}
+			table.offsets[s] = uint32_t(table.values.size());
+			table.last_knots[s] = count - 1;
+			table.scales[s] = T(count);
+			for (int i = 0; i <= count; i++) {
+				table.values.push_back(T(evaluate(f, begin + double(i) / (double(count) * segments))));
+			}
+		}
+		return table;
+	}
+
+	/// Evaluate the table at progress `p`, clamped to `[0, 1]`
+	T operator()(T p) const {
+		T x = (p < 0 ? 0 : (p > 1 ? 1 : p)) * segments;
+		int s = int(x);
+		s = s < segments - 1 ? s : segments - 1;
+		T local = (x - s) * scales[s];
+		int i = int(local);
+		i = i < last_knots[s] ? i : last_knots[s];
+		const T *knot = values.data() + offsets[s] + i;
+		return knot[0] + (local - i) * (knot[1] - knot[0]);
+	}
+
+	/// Total number of stored values
+	size_t size() const {
+		return values.size();
+	}
+
+private:
+	uint32_t offsets[segments];
+	int last_knots[segments];
+	T scales[segments];
+	std::vector<T> values;
+
+	/// Maximum linear interpolation error of `f` in the segment starting at `begin` with `count` intervals, sampled between knots
+	static double segment_error(function f, double begin, int count) {
+		double step = 1.0 / (double(count) * segments);
+		double error = 0;
+		for (int i = 0; i < count; i++) {
+			double x0 = begin + i * step;
+			double y0 = evaluate(f, x0), y1 = evaluate(f, x0 + step);
+			for (int j = 1; j < 8; j++) {
+				double amount = j / 8.0;
+				double diff = evaluate(f, x0 + amount * step) - (y0 + amount * (y1 - y0));
+				diff = diff < 0 ? -diff : diff;
+				error = diff > error ? diff : error;
+			}
+		}
+		return error;
+	}
+};
+
+/// Evaluate an adaptive table at `count` progress values from `p`, writing results to `out`
+template<typename T> void evaluate(const adaptive_table<T>& table, const T *p, T *out, size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		out[i] = table(p[i]);
+	}
+}
+
+
+/// Exact table mapping 8-bit progress to 8-bit or 16-bit eased output, for pipelines like alpha fades, LEDs and PWM.
+/// Entry `i` is the ease function at progress `i / 255`, clamped to `[0, 1]` and rounded to the nearest `Out` step,
+/// so overshooting functions saturate at the ends of the output range.
+/// `build` is constexpr for functions with `traits(f).constexpr_evaluable`, so their tables can be generated at compile time.
+template<typename Out> struct byte_table {
+	static_assert(std::is_same_v<Out, uint8_t> || std::is_same_v<Out, uint16_t>, "byte tables map to uint8_t or uint16_t");
+
+	Out values[256];
+
+	/// Build the table for ease function `f`.
+	/// Unknown enum values behave as `LINEAR`.
+	static constexpr byte_table build(function f) {
+		function_ptr<double> ease_function_ptr = get<double>(f);
+		if (!ease_function_ptr) {
+			ease_function_ptr = linear;
+		}
+		byte_table table {};
+		constexpr double max = Out(~Out(0));
+		for (int i = 0; i < 256; i++) {
+			double value = ease_function_ptr(i / 255.0);
+			value = value < 0 ? 0 : (value > 1 ? 1 : value);
+			table.values[i] = Out(value * max + 0.5);
+		}
+		return table;
+	}
+
+	/// Look up the eased output for 8-bit progress `p`
+	constexpr Out operator()(uint8_t p) const {
+		return values[p];
+	}
+};
+
+/// Byte table of ease function `F`, generated at compile time when the function is constexpr evaluable and on startup otherwise
+template<function F, typename Out = uint8_t> inline const byte_table<Out> byte_table_of = byte_table<Out>::build(F);
+
+namespace detail {
+#if defined(__AVX512VBMI__)
+	/// Look up 64 bytes in a 256 byte table held in 4 registers, with 2 byte permutes over 128 entries selected by the top bit of each index
+	inline __m512i lookup_bytes(const __m512i *table, __m512i index) {
+		__m512i low_half = _mm512_permutex2var_epi8(table[0], index, table[1]);
+		__m512i high_half = _mm512_permutex2var_epi8(table[2], index, table[3]);
+		return _mm512_mask_blend_epi8(_mm512_movepi8_mask(index), low_half, high_half);
+	}
+#endif
+}
+
+/// Apply a byte table to `count` 8-bit progress values from `p`, writing results to `out`.
+/// Uses byte permutes with AVX-512 VBMI when the compiler targets it, and plain table lookups otherwise,
+/// which are faster than emulating 256 entry byte lookups with 16 byte shuffles on narrower vectors.
+template<typename Out> void evaluate(const byte_table<Out>& table, const uint8_t *p, Out *out, size_t count) {
+	size_t i = 0;
+#if defined(__AVX512VBMI__)
+	if constexpr (std::is_same_v<Out, uint8_t>) {
+		__m512i rows[4];
+		for (int j = 0; j < 4; j++) {
+			rows[j] = _mm512_loadu_si512(table.values + 64 * j);
+		}
+		for (; i + 64 <= count; i += 64) {
+			__m512i index = _mm512_loadu_si512(p + i);
+			_mm512_storeu_si512(out + i, detail::lookup_bytes(rows, index));
+		}
+	}
+	else {
+		// Split 16-bit entries in planes of low and high bytes, looked up separately and interleaved back
+		alignas(64) uint8_t planes[2][256];
+		for (int j = 0; j < 256; j++) {
+			planes[0][j] = uint8_t(table.values[j]);
+			planes[1][j] = uint8_t(table.values[j] >> 8);
+		}
+		__m512i low_rows[4], high_rows[4];
+		for (int j = 0; j < 4; j++) {
+			low_rows[j] = _mm512_load_si512(planes[0] + 64 * j);
+			high_rows[j] = _mm512_load_si512(planes[1] + 64 * j);
+		}
+		// Unpacking interleaves within 128-bit lanes, so pick the lanes of both results alternately to put entries back in order
+		const __m512i order = _mm512_set_epi64(11, 10, 3, 2, 9, 8, 1, 0);
+		for (; i + 64 <= count; i += 64) {
+			__m512i index = _mm512_loadu_si512(p + i);
+			__m512i low = detail::lookup_bytes(low_rows, index);
+			__m512i high = detail::lookup_bytes(high_rows, index);
+			__m512i first = _mm512_unpacklo_epi8(low, high), second = _mm512_unpackhi_epi8(low, high);
+			_mm512_storeu_si512(out + i, _mm512_permutex2var_epi64(first, order, second));
+			_mm512_storeu_si512(out + i + 32, _mm512_permutex2var_epi64(first, _mm512_add_epi64(order, _mm512_set1_epi64(4)), second));
+		}
+	}
+#endif
+	for (; i < count; i++) {
+		out[i] = table(p[i]);
+	}
+}
+
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "ease.hpp"
+
+
+namespace ease {
+
+/// Time remapping (speed ramp) driven by an eased playback speed.
+/// Playback speed goes from `speed_from` to `speed_to` over `output_duration`, following an ease function.
+/// Source time is the integral of speed over output time, precomputed in a table of `resolution` uniform steps,
+/// so mapping output time to source time is a direct table index and the reverse mapping a binary search, both monotone.
+/// Negative speeds from overshooting functions are clamped to zero, so source time never goes backwards.
+template<typename T> class time_remap {
+public:
+	time_remap(function curve, T output_duration, T speed_from, T speed_to, int resolution = 1024)
+		: output_length(output_duration)
+		, steps(resolution > 0 ? resolution : 1)
+		, cumulative(steps + 1)
+	{
+		double step = double(output_length) / steps;
+		auto speed = [&](double u) {
+			double s = speed_from + evaluate(curve, u) * (speed_to - speed_from);
+			return s > 0 ? s : 0;
+		};
+		// Simpson's rule in each step
+		double total = 0;
+		cumulative[0] = 0;
+		for (int i = 0; i < steps; i++) {
+			double u0 = double(i) / steps, u1 = double(i + 1) / steps;
+			total += step / 6 * (speed(u0) + 4 * speed((u0 + u1) / 2) + speed(u1));
+			cumulative[i + 1] = T(total);
+		}
+	}
+
+	/// Duration of the retimed clip
+	T output_duration() const {
+		return output_length;
+	}
+
+	/// Amount of source time consumed by the whole retimed clip
+	T source_duration() const {
+		return cumulative.back();
+	}
+
+	/// Map output time to source time.
+	/// Times outside the clip are clamped to its ends.
+	T source_time(T output_time) const {
+		if (!(output_length > 0)) {
+			return 0;
+		}
+		T x = output_time / output_length * steps;
+		x = x < 0 ? 0 : (x > steps ? T(steps) : x);
+		int i = int(x);
+		i = i < steps - 1 ? i : steps - 1;
+		return cumulative[i] + (x - i) * (cumulative[i + 1] - cumulative[i]);
+	}
+
+	/// Map source time back to output time.
+	/// When playback speed is zero for a while, returns the first output time that reaches `source_time`.
+	/// Times outside the clip are clamped to its ends.
+	T output_time(T source_time) const {
+		auto it = std::lower_bound(cumulative.begin() + 1, cumulative.end(), source_time);
+		if (it == cumulative.end()) {
+			return output_length;
+		}
+		size_t i = it - cumulative.begin() - 1;
+		T begin = cumulative[i], end = *it;
+		T amount = end > begin ? (source_time - begin) / (end - begin) : 0;
+		amount = amount < 0 ? 0 : amount;
+		return (i + amount) * output_length / steps;
+	}
+
+	/// Map `count` output times to source times
+	void source_times(const T *output_times, T *out, size_t count) const {
+		for (size_t i = 0; i < count; i++) {
+			out[i] = source_time(output_times[i]);
+		}
+	}
+
+	/// Map `count` source times back to output times
+	void output_times(const T *source_times, T *out, size_t count) const {
+		for (size_t i = 0; i < count; i++) {
+			out[i] = output_time(source_times[i]);
+		}
+	}
+
+private:
+	T output_length;
+	int steps;
+	std::vector<T> cumulative;
+};
+
+}
@@ -0,0 +1,604 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "ease.hpp"
+
+
+namespace ease {
+
+namespace detail {
+	/// Number of trailing one bits in `k`
+	inline int trailing_ones(uint64_t k) {
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_ctzll(~k);
+#else
+		int count = 0;
+		while (k & 1) {
+			k >>= 1;
+			count++;
+		}
+		return count;
+#endif
+	}
+
+#if defined(__AVX2__)
+	/// Descend 16 searches in an Eytzinger tree of floats at once, in 2 registers of 8 lanes, writing the final node indices to `k`.
+	/// Node indices fit in 32-bit lanes for trees of up to 2^30 keys.
+	inline void descend_eytzinger16(const float *tree, const float *times, int depth, uint32_t *k) {
+		__m256i k0 = _mm256_set1_epi32(1), k1 = k0;
+		__m256 x0 = _mm256_loadu_ps(times), x1 = _mm256_loadu_ps(times + 8);
+		for (int level = 0; level < depth; level++) {
+			__m256 node0 = _mm256_i32gather_ps(tree, k0, 4);
+			__m256 node1 = _mm256_i32gather_ps(tree, k1, 4);
+			// Comparison masks are -1 in lanes going right, so subtracting them adds 1
+			k0 = _mm256_sub_epi32(_mm256_add_epi32(k0, k0), _mm256_castps_si256(_mm256_cmp_ps(node0, x0, _CMP_LE_OQ)));
+			k1 = _mm256_sub_epi32(_mm256_add_epi32(k1, k1), _mm256_castps_si256(_mm256_cmp_ps(node1, x1, _CMP_LE_OQ)));
+		}
+		_mm256_storeu_si256((__m256i *) k, k0);
+		_mm256_storeu_si256((__m256i *) (k + 8), k1);
+	}
+#endif
+
+	/// Allocator for arrays starting at a 64-byte cache line boundary
+	template<typename T> struct cache_line_allocator {
+		using value_type = T;
+
+		cache_line_allocator() = default;
+		template<typename U> cache_line_allocator(const cache_line_allocator<U>&) {}
+
+		T *allocate(size_t count) {
+			return static_cast<T *>(::operator new(count * sizeof(T), std::align_val_t(64)));
+		}
+
+		void deallocate(T *pointer, size_t) {
+			::operator delete(pointer, std::align_val_t(64));
+		}
+
+		template<typename U> bool operator==(const cache_line_allocator<U>&) const {
+			return true;
+		}
+
+		template<typename U> bool operator!=(const cache_line_allocator<U>&) const {
+			return false;
+		}
+	};
+
+	/// Add `weight` times the channels interpolated between `from` and `to` by `amount` to `out`
+	template<typename T> void accumulate_blend(const T *from, const T *to, T amount, T weight, T *out, int channels) {
+		for (int c = 0; c < channels; c++) {
+			out[c] += weight * (from[c] + amount * (to[c] - from[c]));
+		}
+	}
+
+	/// Add `weight` times the difference between the channels interpolated between `from` and `to` by `amount` and `reference` to `out`
+	template<typename T> void accumulate_additive(const T *from, const T *to, const T *reference, T amount, T weight, T *out, int channels) {
+		for (int c = 0; c < channels; c++) {
+			out[c] += weight * (from[c] + amount * (to[c] - from[c]) - reference[c]);
+		}
+	}
+}
+
+/// Keyframe track with several channels sharing the same key times, like the position, rotation and scale of a node.
+/// Key times are stored once, and each segment between two keys has its own ease function.
+/// Channel values are stored as one packed row per key, so sampling finds the segment and evaluates its ease function once,
+/// then interpolates all channels in a single loop over two contiguous rows that compilers can vectorize.
+template<typename T> class track {
+public:
+	explicit track(int channel_count)
+		: channels(channel_count > 0 ? channel_count : 1)
+	{
+	}
+
+	/// Append a key at `time` with one value per channel in `values`.
+	/// `curve` eases the segment from this key to the next one.
+	/// Keys must be added in non-decreasing time order.
+	void add_key(T time, const T *values, function curve = LINEAR) {
+		key_times.push_back(time);
+		curves.push_back(curve);
+		key_values.insert(key_values.end(), values, values + channels);
+	}
+
+	/// Number of channels
+	int channel_count() const {
+		return channels;
+	}
+
+	/// Number of keys
+	size_t key_count() const {
+		return key_times.size();
+	}
+
+	/// Time of the first key
+	T start_time() const {
+		return key_times.empty() ? 0 : key_times.front();
+	}
+
+	/// Time of the last key
+	T end_time() const {
+		return key_times.empty() ? 0 : key_times.back();
+	}
+
+	/// Key times, in non-decreasing order
+	const T *times() const {
+		return key_times.data();
+	}
+
+	/// Channel values of key `key`, packed in channel order
+	const T *key(size_t key) const {
+		return key_values.data() + key * channels;
+	}
+
+	/// Ease function of the segment starting at key `key`
+	function curve(size_t key) const {
+		return curves[key];
+	}
+
+	/// Index of the key starting the segment that contains `time`.
+	/// Times before the first key return 0 and times after the last key return the last key.
+	size_t find_segment(T time) const {
+		size_t index = std::upper_bound(key_times.begin(), key_times.end(), time) - key_times.begin();
+		return index > 0 ? index - 1 : 0;
+	}
+
+	/// Eased amount between key `segment` and the next one at `time`, clamped to `[0, 1]` before easing
+	T segment_amount(size_t segment, T time) const {
+		if (segment + 1 >= key_times.size()) {
+			return 0;
+		}
+		T begin = key_times[segment], end = key_times[segment + 1];
+		T progress = end > begin ? (time - begin) / (end - begin) : 1;
+		progress = progress < 0 ? 0 : (progress > 1 ? 1 : progress);
+		return evaluate(curves[segment], progress);
+	}
+
+	/// Sample all channels at `time`, writing `channel_count()` values to `out`.
+	/// Values hold the first key before the track starts and the last key after it ends.
+	/// Tracks without keys write nothing.
+	void sample(T time, T *out) const {
+		if (key_times.empty()) {
+			return;
+		}
+		size_t segment = find_segment(time);
+		sample_segment(segment, segment_amount(segment, time), out);
+	}
+
+	/// Interpolate all channels between key `segment` and the next one by the eased `amount`, writing `channel_count()` values to `out`
+	void sample_segment(size_t segment, T amount, T *out) const {
+		const T *from = key(segment);
+		const T *to = segment + 1 < key_times.size() ? key(segment + 1) : from;
+		for (int c = 0; c < channels; c++) {
+			out[c] = from[c] + amount * (to[c] - from[c]);
+		}
+	}
+
+private:
+	int channels;
+	std::vector<T> key_times;
+	/// Ease function of the segment starting at each key
+	std::vector<function> curves;
+	/// Channel values, one row of `channels` values per key
+	std::vector<T> key_values;
+};
+
+/// How a layer of a `blend_tree` combines with the others
+enum class blend_mode {
+	/// Weighted average with the other override layers, using weights normalized by their sum
+	override,
+	/// Adds the difference between the clip's sampled values and its first key, scaled by the layer weight, on top of the override layers
+	additive,
+};
+
+/// Blends keyframe tracks sampled at their own times, like locomotion blends with additive overlays.
+/// Layer weights can crossfade over time following an ease function.
+/// Evaluation is a single pass that accumulates each layer with non-zero weight directly into the output,
+/// without intermediate buffers per clip, and skips layers whose weight is zero without sampling them.
+/// All clips must have the tree's number of channels and outlive it.
+template<typename T> class blend_tree {
+public:
+	explicit blend_tree(int channel_count)
+		: channels(channel_count > 0 ? channel_count : 1)
+	{
+	}
+
+	/// Add a layer playing `clip` from time 0 with `weight`, returning its index
+	size_t add_layer(const track<T>& clip, blend_mode mode = blend_mode::override, T weight = 1) {
+		layer new_layer {};
+		new_layer.clip = &clip;
+		new_layer.mode = mode;
+		new_layer.weight = new_layer.fade_to = weight;
+		new_layer.fade_curve = LINEAR;
+		layers.push_back(new_layer);
+		return layers.size() - 1;
+	}
+
+	/// Number of layers
+	size_t layer_count() const {
+		return layers.size();
+	}
+
+	/// Set the clip time of a layer
+	void set_time(size_t index, T time) {
+		layers[index].time = time;
+	}
+
+	/// Clip time of a layer
+	T time(size_t index) const {
+		return layers[index].time;
+	}
+
+	/// Set the weight of a layer immediately, cancelling its crossfade
+	void set_weight(size_t index, T weight) {
+		layer& target = layers[index];
+		target.weight = target.fade_to = weight;
+		target.fade_duration = 0;
+	}
+
+	/// Current weight of a layer
+	T weight(size_t index) const {
+		return layers[index].weight;
+	}
+
+	/// Fade the weight of a layer from its current value to `weight` over `duration`, following `curve`
+	void fade(size_t index, T weight, T duration, function curve = IN_OUT_SINE) {
+		layer& target = layers[index];
+		target.fade_from = target.weight;
+		target.fade_to = weight;
+		target.fade_elapsed = 0;
+		target.fade_duration = duration;
+		target.fade_curve = curve;
+		if (!(duration > 0)) {
+			set_weight(index, weight);
+		}
+	}
+
+	/// Crossfade from all other override layers to the override layer `index` over `duration`, following `curve`
+	void crossfade(size_t index, T duration, function curve = IN_OUT_SINE) {
+		for (size_t i = 0; i < layers.size(); i++) {
+			if (layers[i].mode == blend_mode::override) {
+				fade(i, i == index ? 1 : 0, duration, curve);
+			}
+		}
+	}
+
+	/// Advance the clip times and crossfades of all layers by `dt`
+	void advance(T dt) {
+		for (layer& target : layers) {
+			target.time += dt;
+			if (target.fade_duration > 0) {
+				target.fade_elapsed += dt;
+				if (target.fade_elapsed >= target.fade_duration) {
+					target.weight = target.fade_to;
+					target.fade_duration = 0;
+				}
+				else {
+					T amount = ease::evaluate(target.fade_curve, target.fade_elapsed / target.fade_duration);
+					target.weight = target.fade_from + amount * (target.fade_to - target.fade_from);
+				}
+			}
+		}
+	}
+
+	/// Sample and blend all layers, writing `channel_count` values to `out`.
+	/// Without override layers of non-zero weight, additive layers are applied on top of zeros.
+	void evaluate(T *out) const {
+		T override_weight = 0;
+		for (const layer& source : layers) {
+			override_weight += source.mode == blend_mode::override ? source.weight : 0;
+		}
+		T inverse_override_weight = override_weight != 0 ? 1 / override_weight : 0;
+		std::fill(out, out + channels, T(0));
+		for (const layer& source : layers) {
+			if (source.weight == 0 || source.clip->key_count() == 0) {
+				continue;
+			}
+			const track<T>& clip = *source.clip;
+			size_t segment = clip.find_segment(source.time);
+			T amount = clip.segment_amount(segment, source.time);
+			const T *from = clip.key(segment);
+			const T *to = segment + 1 < clip.key_count() ? clip.key(segment + 1) : from;
+			if (source.mode == blend_mode::override) {
+				detail::accumulate_blend(from, to, amount, source.weight * inverse_override_weight, out, channels);
+			}
+			else {
+				detail::accumulate_additive(from, to, clip.key(0), amount, source.weight, out, channels);
+			}
+		}
+	}
+
+private:
+	struct layer {
+		const track<T> *clip;
+		blend_mode mode;
+		T time;
+		T weight;
+		T fade_from;
+		T fade_to;
+		T fade_elapsed;
+		T fade_duration;
+		function fade_curve;
+	};
+
+	int channels;
+	std::vector<layer> layers;
+};
+
+
+/// Samples one track at many times, like crowds of agents playing the same clip at different phases.
+/// Times are sorted, or taken as already sorted, and the keys are swept once with a moving cursor so key data stays hot in cache.
+/// The agents falling in each segment are then processed as a group: progress, ease function and interpolation are batch loops
+/// over the group, with the ease function resolved once per segment.
+/// The sampler keeps its scratch buffers and time order between calls, so sampling every frame doesn't allocate.
+template<typename T> class crowd_sampler {
+public:
+	/// Sample `clip` at `count` times, writing channel `c` of time `i` to `out[c * count + i]`.
+	/// Pass `sorted = true` when times are already in non-decreasing order to skip sorting them.
+	/// Otherwise, when sampling the same number of times as in the previous call, the previous order is reused as a starting point,
+	/// so times that keep their relative order between frames are re-sorted in linear time.
+	/// Values hold the first key before the track starts and the last key after it ends.
+	void sample(const track<T>& clip, const T *times, size_t count, T *out, bool sorted = false) {
+		if (clip.key_count() == 0 || count == 0) {
+			return;
+		}
+		amounts.resize(count);
+		if (sorted) {
+			order.resize(count);
+			for (size_t i = 0; i < count; i++) {
+				order[i] = uint32_t(i);
+			}
+		}
+		else if (order.size() == count) {
+			resort(times);
+		}
+		else {
+			order.resize(count);
+			// Sorting times next to their indices is much more cache friendly than sorting indices by indirect comparisons
+			sorted_times.resize(count);
+			for (size_t i = 0; i < count; i++) {
+				sorted_times[i] = { times[i], uint32_t(i) };
+			}
+			std::sort(sorted_times.begin(), sorted_times.end(), [](const timed_index& a, const timed_index& b) {
+				return a.time < b.time;
+			});
+			for (size_t i = 0; i < count; i++) {
+				order[i] = sorted_times[i].index;
+			}
+		}
+
+		const T *key_times = clip.times();
+		size_t key_count = clip.key_count(), segment = 0;
+		size_t begin = 0;
+		while (begin < count) {
+			// Move the cursor to the segment containing the next time, then gather all times in it
+			while (segment + 1 < key_count && key_times[segment + 1] <= times[order[begin]]) {
+				segment++;
+			}
+			size_t end = begin + 1;
+			if (segment + 1 < key_count) {
+				while (end < count && times[order[end]] < key_times[segment + 1]) {
+					end++;
+				}
+			}
+			else {
+				end = count;
+			}
+			sample_group(clip, segment, times, begin, end, count, out, sorted);
+			begin = end;
+		}
+	}
+
+private:
+	struct timed_index {
+		T time;
+		uint32_t index;
+	};
+
+	/// Restore time order starting from the order of the previous call.
+	/// Agents mostly keep their relative phases between frames, so the previous order is split into a sorted run
+	/// and the few times that moved out of place, like looping agents wrapping back to the start.
+	/// Only those are sorted, then merged back, which is linear when few times moved.
+	void resort(const T *times) {
+		kept.clear();
+		moved.clear();
+		for (uint32_t index : order) {
+			if (kept.empty() || times[index] >= times[kept.back()]) {
+				kept.push_back(index);
+			}
+			else {
+				moved.push_back(index);
+			}
+		}
+		auto time_order = [times](uint32_t a, uint32_t b) {
+			return times[a] < times[b];
+		};
+		std::sort(moved.begin(), moved.end(), time_order);
+		std::merge(kept.begin(), kept.end(), moved.begin(), moved.end(), order.begin(), time_order);
+	}
+
+	/// Interpolate the times at sorted positions `[begin, end)`, which all fall in `segment`
+	void sample_group(const track<T>& clip, size_t segment, const T *times, size_t begin, size_t end, size_t count, T *out, bool sorted) {
+		size_t size = end - begin;
+		T *amount = amounts.data() + begin;
+		const uint32_t *index = order.data() + begin;
+		const T *from = clip.key(segment);
+		const T *to = from;
+		if (segment + 1 < clip.key_count()) {
+			to = clip.key(segment + 1);
+			T key_begin = clip.times()[segment], key_end = clip.times()[segment + 1];
+			T inverse_length = key_end > key_begin ? 1 / (key_end - key_begin) : 0;
+			T empty = key_end > key_begin ? 0 : 1;
+			for (size_t j = 0; j < size; j++) {
+				T progress = std::max(std::min((times[index[j]] - key_begin) * inverse_length + empty, T(1)), T(0));
+				amount[j] = progress;
+			}
+			evaluate(clip.curve(segment), amount, amount, size);
+		}
+		else {
+			std::fill(amount, amount + size, T(0));
+		}
+
+		for (int c = 0; c < clip.channel_count(); c++) {
+			T *channel = out + c * count;
+			T value = from[c], delta = to[c] - from[c];
+			if (sorted) {
+				// Identity order, so writes are contiguous
+				for (size_t j = 0; j < size; j++) {
+					channel[begin + j] = value + amount[j] * delta;
+				}
+			}
+			else {
+				for (size_t j = 0; j < size; j++) {
+					channel[index[j]] = value + amount[j] * delta;
+				}
+			}
+		}
+	}
+
+	std::vector<timed_index> sorted_times;
+	std::vector<uint32_t> kept;
+	std::vector<uint32_t> moved;
+	/// Indices of the sampled times, in time order
+	std::vector<uint32_t> order;
+	/// Eased amounts, in time order
+	std::vector<T> amounts;
+};
+
+
+/// Search index over sorted key times in Eytzinger (breadth-first) order, for random access seeks in long tracks.
+/// The tree is padded to a complete binary tree, so every search takes the same number of steps,
+/// each a branch-free comparison that picks a child, while the cache line holding the descendants a few levels below is prefetched.
+/// Batch searches advance a group of 16 queries level by level, so their memory accesses overlap,
+/// using AVX2 gathers for `float` times when the compiler targets it.
+template<typename T> class eytzinger_index {
+public:
+	/// Build the index over `count` times in non-decreasing order, like `track::times()`
+	eytzinger_index(const T *times, size_t count)
+		: key_count(count)
+	{
+		depth = 0;
+		while ((size_t(1) << depth) <= count) {
+			depth++;
+		}
+		size_t size = size_t(1) << depth;
+		nodes.assign(size, padding());
+		ranks.assign(size, uint32_t(count));
+		size_t position = 0;
+		build(times, 1, position);
+	}
+
+	/// Build the index over the key times of a track
+	explicit eytzinger_index(const track<T>& clip)
+		: eytzinger_index(clip.times(), clip.key_count())
+	{
+	}
+
+	/// Index of the first key time greater than `time`, like `std::upper_bound`
+	size_t upper_bound(T time) const {
+		const T *tree = nodes.data();
+		size_t k = 1, last = nodes.size() - 1;
+		for (int level = 0; level < depth; level++) {
+#if defined(__GNUC__) || defined(__clang__)
+			__builtin_prefetch(tree + std::min(k * prefetch_stride, last));
+#endif
+			k = 2 * k + (tree[k] <= time);
+		}
+		return ranks[k >> (detail::trailing_ones(k) + 1)];
+	}
+
+	/// Index of the key starting the segment that contains `time`, the same as `track::find_segment`
+	size_t find_segment(T time) const {
+		size_t index = upper_bound(time);
+		return index > 0 ? index - 1 : 0;
+	}
+
+	/// Find the segments containing `count` times, writing the same as `find_segment` to `out`.
+	/// Queries are processed in interleaved groups, advancing all of them one level at a time.
+	void find_segments(const T *times, size_t count, uint32_t *out) const {
+		const T *tree = nodes.data();
+		size_t grouped = count - count % group;
+		for (size_t i = 0; i < grouped; i += group) {
+			uint32_t k[group];
+#if defined(__AVX2__)
+			if constexpr (std::is_same_v<T, float>) {
+				detail::descend_eytzinger16(tree, times + i, depth, k);
+			}
+			else
+#endif
+			{
+				for (size_t j = 0; j < group; j++) {
+					k[j] = 1;
+				}
+				for (int level = 0; level < depth; level++) {
+					for (size_t j = 0; j < group; j++) {
+						k[j] = 2 * k[j] + (tree[k[j]] <= times[i + j]);
+					}
+				}
+			}
+			for (size_t j = 0; j < group; j++) {
+				uint32_t index = ranks[k[j] >> (detail::trailing_ones(k[j]) + 1)];
+				out[i + j] = index > 0 ? index - 1 : 0;
+			}
+		}
+		for (size_t i = grouped; i < count; i++) {
+			out[i] = uint32_t(find_segment(times[i]));
+		}
+	}
+
+private:
+	/// Number of queries interleaved by `find_segments`
+	static constexpr size_t group = 16;
+	/// Nodes per 64-byte cache line
+	static constexpr size_t line_nodes = 64 / sizeof(T) > 1 ? 64 / sizeof(T) : 1;
+
+	/// Largest power of two not greater than `n`
+	static constexpr size_t floor_power_of_two(size_t n) {
+		size_t power = 1;
+		while (power * 2 <= n) {
+			power *= 2;
+		}
+		return power;
+	}
+
+	/// The descendants of node `k` that are d levels below are nodes `k * 2^d` to `k * 2^d + 2^d - 1`.
+	/// With node 0 at the start of a cache line, they share one line when `2^d` nodes fit in it,
+	/// that is 4 levels below for `float` and 3 for `double`, so prefetching that line covers the next d steps.
+	static constexpr size_t prefetch_stride = floor_power_of_two(line_nodes);
+
+	static constexpr T padding() {
+		return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+	}
+
+	/// Fill the subtree rooted at `k` with an in-order traversal, so that nodes follow the sorted order of times
+	void build(const T *times, size_t k, size_t& position) {
+		if (k >= nodes.size()) {
+			return;
+		}
+		build(times, 2 * k, position);
+		if (position < key_count) {
+			nodes[k] = times[position];
+			ranks[k] = uint32_t(position);
+		}
+		position++;
+		build(times, 2 * k + 1, position);
+	}
+
+	size_t key_count;
+	int depth;
+	/// Key times in Eytzinger order, starting at index 1, padded with values greater than any time.
+	/// Node 0 starts a cache line.
+	std::vector<T, detail::cache_line_allocator<T>> nodes;
+	/// Sorted index of the key time in each node, or `key_count` for padding and the "not found" node 0
+	std::vector<uint32_t> ranks;
+};
+
+}
@@ -0,0 +1,1308 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "ease.hpp"
+
+
+namespace ease {
+
+namespace detail {
+	/// Returns the clamped `[0, 1]` progress of a tween that started at `start_time` and lasts for `duration`.
+	/// Tweens with non-positive duration are considered finished as soon as they start.
+	template<typename T> constexpr T progress(T start_time, T duration, T now) {
+		if (now < start_time) {
+			return 0;
+		}
+		else if (now >= start_time + duration) {
+			return 1;
+		}
+		else {
+			return (now - start_time) / duration;
+		}
+	}
+
+	/// Linear interpolation between `from` and `to`
+	template<typename T> constexpr T lerp(T from, T to, T amount) {
+		return from + amount * (to - from);
+	}
+
+	/// Returns the index of the lowest set bit in `word`, which must not be zero
+	inline int lowest_bit(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_ctzll(word);
+#else
+		int index = 0;
+		while (!(word & 1)) {
+			word >>= 1;
+			index++;
+		}
+		return index;
+#endif
+	}
+
+	/// Number of 64-bit words needed for a bitset with `count` bits
+	constexpr size_t bit_words(size_t count) {
+		return (count + 63) / 64;
+	}
+
+	/// Appends the indices of all set bits in `bits` to `indices`, in increasing order
+	inline void append_set_bits(const std::vector<uint64_t>& bits, std::vector<uint32_t>& indices) {
+		for (size_t w = 0; w < bits.size(); w++) {
+			for (uint64_t word = bits[w]; word; word &= word - 1) {
+				indices.push_back(uint32_t(w * 64 + lowest_bit(word)));
+			}
+		}
+	}
+
+	/// Returns the inverse of a positive `duration`, rounded up so that `duration * inverse` is never less than 1
+	template<typename T, typename Time> T inverse_duration(Time duration) {
+		T inverse = 1 / T(duration);
+		if (T(duration) * inverse < 1) {
+			inverse = std::nextafter(inverse, T(2) * inverse);
+		}
+		return inverse;
+	}
+
+	/// Advance `elapsed` times by `dt` without going past `durations`, writing the resulting `[0, 1]` progress to `progress`.
+	/// Negative elapsed times are delays, with progress 0.
+	/// Progress is computed by multiplying with inverse durations from `inverse_duration`, so that finished tweens get exactly 1,
+	/// in a branch-free loop compilers can vectorize.
+	template<typename T, typename Time> void advance_progress(Time *elapsed, const Time *durations, const T *inverse_durations, T *progress, size_t count, Time dt) {
+		for (size_t i = 0; i < count; i++) {
+			Time time = std::min(elapsed[i] + dt, durations[i]);
+			elapsed[i] = time;
+			progress[i] = std::max(std::min(T(time) * inverse_durations[i], T(1)), T(0));
+		}
+	}
+
+	/// Same as `advance_progress`, with each tween's time step scaled by its own non-negative `speeds`.
+	/// With integer `Time`, the fraction of a tick truncated from each scaled step is kept in `remainders` and added to the next one,
+	/// so tweens slowed down below one tick per update still advance.
+	template<typename T, typename Time> void advance_progress_scaled(Time *elapsed, const Time *durations, const T *inverse_durations, const T *speeds, T *remainders, T *progress, size_t count, Time dt) {
+		for (size_t i = 0; i < count; i++) {
+			Time step;
+			if constexpr (std::is_integral_v<Time>) {
+				T scaled = T(dt) * speeds[i] + remainders[i];
+				step = Time(scaled);
+				remainders[i] = scaled - T(step);
+			}
+			else {
+				step = Time(T(dt) * speeds[i]);
+			}
+			Time time = std::min(elapsed[i] + step, durations[i]);
+			elapsed[i] = time;
+			progress[i] = std::max(std::min(T(time) * inverse_durations[i], T(1)), T(0));
+		}
+	}
+
+	/// Transform `progress` in place with the ease functions in `curves`, fetching the function pointer only when the curve changes.
+	/// Unknown curves fall back to linear.
+	template<typename T> void apply_curves(const function *curves, T *progress, size_t count) {
+#ifdef EASE_COMPACT
+		for (size_t i = 0; i < count; i++) {
+			progress[i] = evaluate(curves[i], progress[i]);
+		}
+#else
+		size_t i = 0;
+		while (i < count) {
+			function curve = curves[i];
+			size_t end = i + 1;
+			while (end < count && curves[end] == curve) {
+				end++;
+			}
+			if (auto ease_function_ptr = get<T>(curve)) {
+				for (; i < end; i++) {
+					progress[i] = ease_function_ptr(progress[i]);
+				}
+			}
+			i = end;
+		}
+#endif
+	}
+
+	/// Lerp eased amounts into `values` for the 64-slot block starting at `begin`, returning a bitmask of values that moved more than `epsilon`
+	/// away from their last reported value in `reported`, or whose bit is set in `fresh`.
+	/// Reported values are updated for the returned bits, so changes smaller than `epsilon` add up until they are reported.
+	/// The loop is branch-free so compilers can vectorize it.
+	template<typename T> uint64_t lerp_block(const T *from, const T *to, const T *amount, T *values, T *reported, size_t begin, size_t end, T epsilon, uint64_t fresh) {
+		uint64_t word = 0;
+		for (size_t i = begin; i < end; i++) {
+			T value = lerp(from[i], to[i], amount[i]);
+			uint64_t changed = (std::abs(value - reported[i]) > epsilon) | ((fresh >> (i - begin)) & 1);
+			values[i] = value;
+			reported[i] = changed ? value : reported[i];
+			word |= changed << (i - begin);
+		}
+		return word;
+	}
+
+	/// Lerp one component of packed values by eased amounts, accumulating the largest distance of each value from its last reported value in `delta`.
+	/// The loop is branch-free so compilers can vectorize it.
+	template<typename T> void lerp_component(const T *from, const T *to, const T *amount, T *values, const T *reported, T *delta, size_t count) {
+		for (size_t i = 0; i < count; i++) {
+			T value = lerp(from[i], to[i], amount[i]);
+			delta[i] = std::max(delta[i], std::abs(value - reported[i]));
+			values[i] = value;
+		}
+	}
+
+	/// Compute the inverse lengths of lerped quaternions whose components are stored in separate arrays, for normalizing them.
+	/// The loop is branch-free, but compilers only vectorize its square root when `errno` is not needed, like with `-fno-math-errno`.
+	template<typename T> void inverse_lerp_lengths(const std::vector<T> *from, const std::vector<T> *to, const T *amount, T *inverse_lengths, size_t count) {
+		const T *fx = from[0].data(), *fy = from[1].data(), *fz = from[2].data(), *fw = from[3].data();
+		const T *tx = to[0].data(), *ty = to[1].data(), *tz = to[2].data(), *tw = to[3].data();
+		for (size_t i = 0; i < count; i++) {
+			T x = lerp(fx[i], tx[i], amount[i]);
+			T y = lerp(fy[i], ty[i], amount[i]);
+			T z = lerp(fz[i], tz[i], amount[i]);
+			T w = lerp(fw[i], tw[i], amount[i]);
+			// Endpoints are in the same hemisphere, so the length never gets below sqrt(0.5)
+			inverse_lengths[i] = 1 / std::sqrt(x * x + y * y + z * z + w * w);
+		}
+	}
+
+	/// Same as `lerp_component`, multiplying each lerped value by `scale`
+	template<typename T> void lerp_component(const T *from, const T *to, const T *amount, const T *scale, T *values, const T *reported, T *delta, size_t count) {
+		for (size_t i = 0; i < count; i++) {
+			T value = lerp(from[i], to[i], amount[i]) * scale[i];
+			delta[i] = std::max(delta[i], std::abs(value - reported[i]));
+			values[i] = value;
+		}
+	}
+}
+
+/// Stateless tween, evaluated on demand from a global clock.
+/// There is no per-frame update: the value is computed from the start time, duration, curve and endpoints whenever it is read,
+/// so tweens that are rarely read (e.g. in hidden panels) cost nothing until they are.
+template<typename T> struct lazy_tween {
+	T start_time;
+	T duration;
+	function curve;
+	T from;
+	T to;
+
+	/// Clamped `[0, 1]` progress at clock time `now`
+	constexpr T progress(T now) const {
+		return detail::progress(start_time, duration, now);
+	}
+
+	/// Whether the tween has reached its end value at clock time `now`
+	constexpr bool finished(T now) const {
+		return now >= start_time + duration;
+	}
+
+	/// Eased value at clock time `now`.
+	/// Unknown curves fall back to linear.
+	T value(T now) const {
+		return detail::lerp(from, to, evaluate(curve, progress(now)));
+	}
+
+	/// Range of values the tween reaches between clock times `begin` and `end`, including overshoots
+	interval<T> bounds(T begin, T end) const {
+		interval<T> amount = ease::bounds(curve, progress(begin), progress(end));
+		T first = detail::lerp(from, to, amount.min), last = detail::lerp(from, to, amount.max);
+		return first < last ? interval<T>{ first, last } : interval<T>{ last, first };
+	}
+};
+
+/// Sample `count` lazy tweens at clock time `now`, writing their values to `out`.
+template<typename T> void sample(const lazy_tween<T> *tweens, size_t count, T now, T *out) {
+	for (size_t i = 0; i < count; i++) {
+		out[i] = tweens[i].value(now);
+	}
+}
+
+/// Sample only the lazy tweens listed in `indices` at clock time `now`, writing the value of `tweens[indices[i]]` to `out[i]`.
+/// Use this to read just the values a frame actually needs, so the cost is proportional to the number of reads instead of the number of tweens.
+template<typename T> void sample(const lazy_tween<T> *tweens, const uint32_t *indices, size_t count, T now, T *out) {
+	for (size_t i = 0; i < count; i++) {
+		out[i] = tweens[indices[i]].value(now);
+	}
+}
+
+/// Get the ranges of values that `count` lazy tweens reach between clock times `begin` and `end`.
+/// Objects whose range stays offscreen during a frame don't need to be re-evaluated.
+template<typename T> void bounds(const lazy_tween<T> *tweens, size_t count, T begin, T end, interval<T> *out) {
+	for (size_t i = 0; i < count; i++) {
+		out[i] = tweens[i].bounds(begin, end);
+	}
+}
+
+/// Identifier for tweens in a `tween_pool`.
+/// Identifiers of removed tweens are reused by tweens added afterwards.
+using tween_id = uint32_t;
+
+/// Tween identifier that never refers to a tween
+inline constexpr tween_id invalid_tween = ~tween_id(0);
+
+/// How `tween_pool::animate` handles a property that is already animating
+enum class overwrite {
+	/// Remove the running tween and start the new one from the given start value
+	replace,
+	/// Remove the running tween and start the new one from the running tween's current value, so the property doesn't jump
+	blend,
+	/// Start the new tween from the running tween's end value, right after it finishes, taking over its destination binding then
+	queue,
+};
+
+/// Event fired when a watched tween crosses a threshold value
+template<typename Time> struct tween_event {
+	/// Tween that crossed the threshold
+	tween_id id;
+	/// User tag passed to `tween_pool::watch`
+	uint32_t tag;
+	/// Pool time of the crossing, which may be earlier than the update that fired it
+	Time time;
+};
+
+namespace detail {
+	/// Bookkeeping shared by tween pools: identifier allocation, timing records, ease functions and alive, fresh and dirty bitsets.
+	/// Pools resize their own per-identifier arrays to `capacity()` after allocating identifiers.
+	template<typename T, typename Time> class tween_slots {
+	public:
+		/// Whether `id` refers to a tween currently in the pool
+		bool alive(tween_id id) const {
+			return id < elapsed.size() && (alive_bits[id / 64] >> (id % 64)) & 1;
+		}
+
+		/// Whether the tween reached its end value
+		bool finished(tween_id id) const {
+			return elapsed[id] >= durations[id];
+		}
+
+		/// Values that change by at most `epsilon` in an update are not reported as changed.
+		/// Defaults to 0, so that any change is reported.
+		void set_epsilon(T epsilon) {
+			epsilon_threshold = epsilon;
+		}
+
+		/// Change threshold used by updates
+		T epsilon() const {
+			return epsilon_threshold;
+		}
+
+		/// Whether the tween's value changed in the last update
+		bool dirty(tween_id id) const {
+			return (dirty_bits[id / 64] >> (id % 64)) & 1;
+		}
+
+		/// Dirty bitset from the last update, with one bit per tween identifier, 64 identifiers per word
+		const std::vector<uint64_t>& dirty_mask() const {
+			return dirty_bits;
+		}
+
+		/// Identifiers of tweens whose value changed in the last update, in increasing order
+		const std::vector<tween_id>& changed() const {
+			return changed_ids;
+		}
+
+		/// Number of tween slots, including removed ones.
+		/// Valid identifiers are always smaller than this.
+		size_t capacity() const {
+			return elapsed.size();
+		}
+
+		/// Number of tweens currently in the pool
+		size_t size() const {
+			return elapsed.size() - free_ids.size();
+		}
+
+	protected:
+		/// Take a free identifier, or append a new slot, and start a tween with `curve` that lasts `duration` after `delay`.
+		/// The tween is marked alive and fresh, so it is reported as changed in the next update.
+		tween_id allocate(function curve, Time duration, Time delay) {
+			tween_id id;
+			if (!free_ids.empty()) {
+				id = free_ids.back();
+				free_ids.pop_back();
+			}
+			else {
+				id = tween_id(elapsed.size());
+				elapsed.push_back(0);
+				durations.push_back(0);
+				inverse_durations.push_back(0);
+				curves.push_back(LINEAR);
+				amounts.push_back(0);
+				alive_bits.resize(bit_words(elapsed.size()));
+				fresh_bits.resize(alive_bits.size());
+				dirty_bits.resize(alive_bits.size());
+			}
+			set_timing(id, duration);
+			elapsed[id] -= delay;
+			curves[id] = curve;
+			alive_bits[id / 64] |= uint64_t(1) << (id % 64);
+			mark_fresh(id);
+			return id;
+		}
+
+		/// Clear a tween's bits and timing and make its identifier available for reuse
+		void release(tween_id id) {
+			alive_bits[id / 64] &= ~(uint64_t(1) << (id % 64));
+			fresh_bits[id / 64] &= ~(uint64_t(1) << (id % 64));
+			dirty_bits[id / 64] &= ~(uint64_t(1) << (id % 64));
+			// Keep removed slots finished and constant, so updates don't report them as changing
+			elapsed[id] = durations[id] = 0;
+			inverse_durations[id] = 0;
+			curves[id] = LINEAR;
+			free_ids.push_back(id);
+		}
+
+		/// Restart a tween's timing with `duration`
+		void set_timing(tween_id id, Time duration) {
+			if (duration > 0) {
+				elapsed[id] = 0;
+				durations[id] = duration;
+			}
+			else {
+				// Tweens without duration start finished
+				elapsed[id] = durations[id] = 1;
+			}
+			inverse_durations[id] = inverse_duration<T>(durations[id]);
+		}
+
+		/// Report a tween as changed in the next update
+		void mark_fresh(tween_id id) {
+			fresh_bits[id / 64] |= uint64_t(1) << (id % 64);
+		}
+
+		/// Refresh the changed index list from the dirty bits
+		void collect_changed() {
+			changed_ids.clear();
+			append_set_bits(dirty_bits, changed_ids);
+		}
+
+		std::vector<Time> elapsed;
+		std::vector<Time> durations;
+		std::vector<T> inverse_durations;
+		std::vector<function> curves;
+		std::vector<T> amounts;
+		std::vector<uint64_t> alive_bits;
+		std::vector<uint64_t> fresh_bits;
+		std::vector<uint64_t> dirty_bits;
+		std::vector<tween_id> changed_ids;
+		std::vector<tween_id> free_ids;
+		T epsilon_threshold = 0;
+	};
+}
+
+/// Pool of stateful tweens stored as structure of arrays, updated all at once every frame.
+/// Each update also produces a dirty bitset and a compacted index list of tweens whose value changed more than `epsilon()`,
+/// so downstream systems like layout, GPU buffer uploads or network sync only touch changed data.
+///
+/// `Time` is the type used for elapsed time and durations, which defaults to `T`.
+/// Using an integer type, like nanoseconds or audio samples in `int64_t` or milliseconds in `int32_t`, tracks time in exact ticks:
+/// elapsed time never drifts over long sessions, results are reproducible, and progress is computed as `elapsed * inverse_duration`
+/// with integer and multiply only vector math, without per-tween divisions.
+template<typename T, typename Time = T> class tween_pool : public detail::tween_slots<T, Time> {
+	using base = detail::tween_slots<T, Time>;
+
+public:
+	using base::alive;
+	using base::finished;
+	using base::set_epsilon;
+	using base::epsilon;
+	using base::dirty;
+	using base::dirty_mask;
+	using base::changed;
+	using base::capacity;
+	using base::size;
+
+	/// Add a tween that eases from `from` to `to` in `duration` time units with `curve`, starting after `delay` time units.
+	/// The new tween is reported as changed in the next update.
+	tween_id add(function curve, T from, T to, Time duration, Time delay = 0) {
+		tween_id id = allocate(curve, duration, delay);
+		if (froms.size() < capacity()) {
+			froms.resize(capacity(), 0);
+			tos.resize(capacity(), 0);
+			values.resize(capacity(), 0);
+			reported_values.resize(capacity(), 0);
+			generations.resize(capacity(), 0);
+			destinations.resize(capacity(), nullptr);
+			queued_destinations.resize(capacity(), nullptr);
+			queued_previous.resize(capacity(), invalid_tween);
+			queued_next.resize(capacity(), invalid_tween);
+			tag_masks.resize(capacity(), 0);
+			property_keys.resize(capacity(), { nullptr, 0 });
+			time_scales.resize(capacity(), 1);
+			speeds.resize(capacity(), 1);
+			remainders.resize(capacity(), 0);
+		}
+		froms[id] = from;
+		tos[id] = to;
+		values[id] = reported_values[id] = from;
+		return id;
+	}
+
+	/// Add a tween that moves from `from` to the landing position of `motion`, following the fling's normalized curve until it stops
+	tween_id add(const fling<T>& motion, T from) {
+		static_assert(std::is_same_v<T, Time>, "flings are only supported when time is measured in the value type");
+		T duration = motion.stop_time();
+		tween_id id = add(LINEAR, from, from + motion.stop_position(), duration);
+		fling_decays.push_back({ id, motion.friction * duration });
+		return id;
+	}
+
+	/// Remove a tween, making its identifier available for reuse.
+	/// Removed tweens are never reported as changed.
+	void remove(tween_id id) {
+		if (!alive(id)) {
+			return;
+		}
+		froms[id] = tos[id] = values[id] = reported_values[id] = 0;
+		forget_fling(id);
+		forget_watches(id);
+		forget_queued_binding(id);
+		generations[id]++;
+		bind(id, nullptr);
+		tag_masks[id] = 0;
+		time_scales[id] = speeds[id] = 1;
+		remainders[id] = 0;
+		unindex(id);
+		release(id);
+	}
+
+	/// Restart a tween from `from` towards `to` over `duration`, as if `elapsed_time` already passed, keeping its ease function.
+	/// Flings become linear tweens.
+	/// The value is recomputed immediately and reported as changed in the next update.
+	void retarget(tween_id id, T from, T to, Time duration, Time elapsed_time = 0) {
+		if (!alive(id)) {
+			return;
+		}
+		forget_fling(id);
+		forget_watches(id);
+		generations[id]++;
+		set_timing(id, duration);
+		remainders[id] = 0;
+		froms[id] = from;
+		tos[id] = to;
+		detail::advance_progress(elapsed.data() + id, durations.data() + id, inverse_durations.data() + id, amounts.data() + id, 1, elapsed_time);
+		values[id] = detail::lerp(from, to, evaluate(curves[id], amounts[id]));
+		mark_fresh(id);
+		if (queued_next[id] != invalid_tween) {
+			reschedule_queued(0);
+		}
+	}
+
+	/// Restart a tween from its current value towards `to` over `duration`
+	void retarget(tween_id id, T to, Time duration) {
+		if (alive(id)) {
+			retarget(id, values[id], to, duration);
+		}
+	}
+
+	/// Current value of a tween
+	T value(tween_id id) const {
+		return values[id];
+	}
+
+	/// Advance all tweens by `dt` time units, recomputing their values, the dirty bitset and the changed index list.
+	void update(Time dt) {
+		update_blocks(dt, 0, block_count());
+		finish_update(dt);
+	}
+
+	/// Number of blocks of 64 tweens, the unit of work for `update_blocks`
+	size_t block_count() const {
+		return dirty_bits.size();
+	}
+
+	/// Advance only the tweens in blocks `[first_block, last_block)` by `dt` time units, recomputing their values and dirty bits.
+	/// Disjoint block ranges may be updated concurrently.
+	/// Call `finish_update` once all blocks were updated to refresh the changed index list and fire events.
+	/// Blocks past `block_count()` are ignored.
+	void update_blocks(Time dt, size_t first_block, size_t last_block) {
+		last_block = std::min(last_block, block_count());
+		size_t begin = first_block * 64, end = std::min(last_block * 64, elapsed.size());
+		if (begin >= end) {
+			return;
+		}
+		size_t count = end - begin;
+		if (unit_speed) {
+			detail::advance_progress(elapsed.data() + begin, durations.data() + begin, inverse_durations.data() + begin, amounts.data() + begin, count, dt);
+		}
+		else {
+			detail::advance_progress_scaled(elapsed.data() + begin, durations.data() + begin, inverse_durations.data() + begin, speeds.data() + begin, remainders.data() + begin, amounts.data() + begin, count, dt);
+		}
+		detail::apply_curves(curves.data() + begin, amounts.data() + begin, count);
+		// Fling tweens use LINEAR, so their amount is still the raw progress here
+		for (const fling_decay& fling : fling_decays) {
+			if (fling.id >= begin && fling.id < end) {
+				amounts[fling.id] = detail::fling_curve(fling.decay, amounts[fling.id]);
+			}
+		}
+		for (size_t w = first_block; w < last_block; w++) {
+			size_t block_begin = w * 64, block_end = std::min(block_begin + 64, end);
+			uint64_t word = detail::lerp_block(froms.data(), tos.data(), amounts.data(), values.data(), reported_values.data(), block_begin, block_end, epsilon_threshold, fresh_bits[w]);
+			dirty_bits[w] = word & alive_bits[w];
+			fresh_bits[w] = 0;
+		}
+	}
+
+	/// Advance the pool clock by `dt`, refresh the changed index list from the dirty bits of the last update and fire due events
+	void finish_update(Time dt) {
+		hand_over_bindings();
+		collect_changed();
+		write_bindings();
+		clock += dt;
+		fired_events.clear();
+		while (!timers.empty() && timers.front().time <= clock) {
+			std::pop_heap(timers.begin(), timers.end(), timer_after);
+			const timer& due = timers.back();
+			if (due.generation == generations[due.id]) {
+				fired_events.push_back({ due.id, due.tag, due.time });
+			}
+			timers.pop_back();
+		}
+	}
+
+	/// Schedule events for every time the tween's value crosses `threshold` from now until it finishes.
+	/// Crossing times are solved once here, by inverting the ease function, including every crossing of non-monotone functions like `OUT_BACK` or `OUT_ELASTIC`.
+	/// They are fired by the update that reaches them, so there are no per-frame comparisons.
+	/// Event times follow the tween's time scale and are rescheduled by `pause`, `resume` and `set_time_scale`.
+	/// `complete` fires the pending events in the next update.
+	/// Pending events are dropped if the tween is removed or retargeted.
+	void watch(tween_id id, T threshold, uint32_t tag) {
+		if (!alive(id) || froms[id] == tos[id]) {
+			return;
+		}
+		watches.push_back({ id, tag, (threshold - froms[id]) / (tos[id] - froms[id]) });
+		schedule(watches.back(), schedule_mode::watch);
+	}
+
+	/// Bind a tween to a destination, so updates write its value there directly whenever it changes.
+	/// Writes are done in address order, for better locality and write combining than a separate copy-out pass.
+	/// The current value is written in the next update.
+	/// Pass `nullptr` to unbind. Removing a tween also unbinds it.
+	void bind(tween_id id, T *destination) {
+		if (id >= destinations.size() || destinations[id] == destination) {
+			return;
+		}
+		destinations[id] = destination;
+		bindings_sorted = false;
+		if (destination) {
+			mark_fresh(id);
+		}
+	}
+
+	/// Animate a property of a target object, resolving conflicts with a tween already animating it according to `mode`.
+	/// Tweens are found through a hash index from `(target, property)`, so overwriting is O(1) regardless of the number of tweens.
+	/// `from` is used as the start value when the property isn't animating or `mode` is `overwrite::replace`.
+	/// Replaced and blended tweens pass their destination binding and tags to the new tween.
+	/// Replacing or blending a queued tween also removes the running tween it waits for.
+	/// Queued tweens copy the tags and start when the tween before them finishes, following its pauses, time scale and completion.
+	/// They take over the binding when they start, so the running tween keeps writing it until then.
+	tween_id animate(const void *target, uint32_t property, function curve, T from, T to, Time duration, overwrite mode = overwrite::replace) {
+		property_key key { target, property };
+		auto it = property_index.find(key);
+		if (it == property_index.end()) {
+			tween_id id = add(curve, from, to, duration);
+			index(id, key);
+			return id;
+		}
+
+		tween_id previous = it->second;
+		if (mode == overwrite::queue) {
+			tween_id id = add(curve, tos[previous], to, duration);
+			// Queued tweens hold their start value until they start, so they only need reporting from then on
+			fresh_bits[id / 64] &= ~(uint64_t(1) << (id % 64));
+			// The previous tween stays alive but unindexed, so later conflicts resolve against the queued one
+			property_keys[previous] = { nullptr, 0 };
+			queued_destinations[id] = queued_destination(previous);
+			queued_previous[id] = previous;
+			queued_next[previous] = id;
+			queued_ids.push_back(id);
+			schedule_queued(id);
+			tag_masks[id] = tag_masks[previous];
+			index(id, key);
+			return id;
+		}
+
+		// Queued tweens that didn't start yet hold their start value, so blend from the tween currently animating the property
+		tween_id running = previous;
+		while (elapsed[running] < 0 && queued_previous[running] != invalid_tween) {
+			running = queued_previous[running];
+		}
+		T start = mode == overwrite::blend ? values[running] : from;
+		T *destination = queued_destination(previous);
+		uint64_t tags = tag_masks[previous];
+		// The running tween is overwritten along with the tweens queued after it
+		for (tween_id id = previous; id != invalid_tween;) {
+			tween_id before = id != running ? queued_previous[id] : invalid_tween;
+			remove(id);
+			id = before;
+		}
+		tween_id id = add(curve, start, to, duration);
+		bind(id, destination);
+		tag_masks[id] = tags;
+		index(id, key);
+		return id;
+	}
+
+	/// Find the tween animating a property of a target object, or `invalid_tween` if there is none
+	tween_id find(const void *target, uint32_t property) const {
+		auto it = property_index.find({ target, property });
+		return it != property_index.end() ? it->second : invalid_tween;
+	}
+
+	/// Set the 64-bit tag mask of a tween, used to select it in bulk operations
+	void set_tags(tween_id id, uint64_t tags) {
+		if (alive(id)) {
+			tag_masks[id] = tags;
+		}
+	}
+
+	/// Tag mask of a tween
+	uint64_t tags(tween_id id) const {
+		return tag_masks[id];
+	}
+
+	/// Pause all tweens sharing any tag with `mask`
+	void pause(uint64_t mask) {
+		bool all_unit = true;
+		for (size_t i = 0; i < speeds.size(); i++) {
+			speeds[i] = (tag_masks[i] & mask) ? 0 : speeds[i];
+			all_unit &= speeds[i] == 1;
+		}
+		unit_speed = all_unit;
+		reschedule_queued(mask);
+		reschedule(mask, schedule_mode::reschedule);
+	}
+
+	/// Resume all tweens sharing any tag with `mask`, at their time scale
+	void resume(uint64_t mask) {
+		bool all_unit = true;
+		for (size_t i = 0; i < speeds.size(); i++) {
+			speeds[i] = (tag_masks[i] & mask) ? time_scales[i] : speeds[i];
+			all_unit &= speeds[i] == 1;
+		}
+		unit_speed = all_unit;
+		reschedule_queued(mask);
+		reschedule(mask, schedule_mode::reschedule);
+	}
+
+	/// Set the non-negative time scale of all tweens sharing any tag with `mask`.
+	/// Paused tweens keep paused and use the new scale when resumed.
+	void set_time_scale(uint64_t mask, T scale) {
+		bool all_unit = true;
+		for (size_t i = 0; i < speeds.size(); i++) {
+			bool match = tag_masks[i] & mask;
+			speeds[i] = match && speeds[i] != 0 ? scale : speeds[i];
+			time_scales[i] = match ? scale : time_scales[i];
+			all_unit &= speeds[i] == 1;
+		}
+		unit_speed = all_unit;
+		reschedule_queued(mask);
+		reschedule(mask, schedule_mode::reschedule);
+	}
+
+	/// Jump all tweens sharing any tag with `mask` to their end, which is reflected in the next update.
+	/// Watched thresholds the tweens didn't cross yet fire in the next update too.
+	void complete(uint64_t mask) {
+		reschedule(mask, schedule_mode::complete);
+		for (size_t i = 0; i < elapsed.size(); i++) {
+			elapsed[i] = (tag_masks[i] & mask) ? durations[i] : elapsed[i];
+		}
+		reschedule_queued(mask);
+	}
+
+	/// Remove all tweens sharing any tag with `mask`
+	void kill(uint64_t mask) {
+		for (tween_id id = 0; id < tag_masks.size(); id++) {
+			if (tag_masks[id] & mask) {
+				remove(id);
+			}
+		}
+	}
+
+	/// Events fired in the last update, in time order
+	const std::vector<tween_event<Time>>& events() const {
+		return fired_events;
+	}
+
+	/// Pool time, the sum of all update time steps
+	Time time() const {
+		return clock;
+	}
+
+	/// Values of all tweens, indexed by identifier.
+	/// Slots of removed tweens hold zero.
+	const T *data() const {
+		return values.data();
+	}
+
+private:
+	using base::allocate;
+	using base::release;
+	using base::set_timing;
+	using base::mark_fresh;
+	using base::collect_changed;
+	using base::elapsed;
+	using base::durations;
+	using base::inverse_durations;
+	using base::curves;
+	using base::amounts;
+	using base::alive_bits;
+	using base::fresh_bits;
+	using base::dirty_bits;
+	using base::epsilon_threshold;
+
+	struct property_key {
+		const void *target;
+		uint32_t property;
+
+		bool operator==(const property_key& other) const {
+			return target == other.target && property == other.property;
+		}
+	};
+
+	struct property_key_hash {
+		size_t operator()(const property_key& key) const {
+			return std::hash<const void *>()(key.target) ^ (size_t(key.property) * size_t(0x9E3779B97F4A7C15ull));
+		}
+	};
+
+	struct fling_decay {
+		tween_id id;
+		T decay;
+	};
+
+	void index(tween_id id, property_key key) {
+		property_keys[id] = key;
+		property_index[key] = id;
+	}
+
+	void unindex(tween_id id) {
+		property_key key = property_keys[id];
+		if (key.target) {
+			auto it = property_index.find(key);
+			if (it != property_index.end() && it->second == id) {
+				property_index.erase(it);
+			}
+			property_keys[id] = { nullptr, 0 };
+		}
+	}
+
+	const fling_decay *find_fling(tween_id id) const {
+		for (const fling_decay& fling : fling_decays) {
+			if (fling.id == id) {
+				return &fling;
+			}
+		}
+		return nullptr;
+	}
+
+	/// Write changed values to bound destinations, sorted by address
+	void write_bindings() {
+		if (!bindings_sorted) {
+			bound_ids.clear();
+			for (tween_id id = 0; id < destinations.size(); id++) {
+				if (destinations[id]) {
+					bound_ids.push_back(id);
+				}
+			}
+			std::sort(bound_ids.begin(), bound_ids.end(), [this](tween_id a, tween_id b) {
+				return std::less<T *>()(destinations[a], destinations[b]);
+			});
+			bindings_sorted = true;
+		}
+		for (tween_id id : bound_ids) {
+			if (dirty(id)) {
+				*destinations[id] = values[id];
+			}
+		}
+	}
+
+	void forget_fling(tween_id id) {
+		for (size_t i = 0; i < fling_decays.size(); i++) {
+			if (fling_decays[i].id == id) {
+				fling_decays[i] = fling_decays.back();
+				fling_decays.pop_back();
+				break;
+			}
+		}
+	}
+
+	/// Destination a tween is bound to, or will be bound to when it starts if it is queued
+	T *queued_destination(tween_id id) const {
+		return queued_destinations[id] ? queued_destinations[id] : destinations[id];
+	}
+
+	/// Bind queued tweens that started to the destination of the tween before them, reporting them as changed in this update
+	void hand_over_bindings() {
+		for (size_t i = 0; i < queued_ids.size();) {
+			tween_id id = queued_ids[i];
+			if (alive(id) && elapsed[id] < 0) {
+				i++;
+				continue;
+			}
+			// Removed tweens are only dropped from the list here
+			tween_id previous = queued_previous[id];
+			T *destination = queued_destinations[id];
+			if (previous != invalid_tween) {
+				queued_next[previous] = invalid_tween;
+				if (destination && destinations[previous] == destination) {
+					bind(previous, nullptr);
+				}
+			}
+			if (destination) {
+				destinations[id] = destination;
+				bindings_sorted = false;
+				dirty_bits[id / 64] |= uint64_t(1) << (id % 64);
+			}
+			queued_destinations[id] = nullptr;
+			queued_previous[id] = invalid_tween;
+			queued_ids[i] = queued_ids.back();
+			queued_ids.pop_back();
+		}
+	}
+
+	/// Pool time until a tween finishes at its current speed, including the time it waits for the tweens queued before it.
+	/// Returns false if it or a tween before it is paused, so it won't finish until resumed.
+	bool time_to_finish(tween_id id, T& time) const {
+		if (elapsed[id] >= durations[id]) {
+			time = 0;
+			return true;
+		}
+		if (speeds[id] == 0) {
+			return false;
+		}
+		T start = 0;
+		if (elapsed[id] < 0 && queued_previous[id] != invalid_tween) {
+			if (!time_to_finish(queued_previous[id], start)) {
+				return false;
+			}
+		}
+		else if (elapsed[id] < 0) {
+			start = T(-elapsed[id]) / speeds[id];
+		}
+		time = start + T(durations[id] - std::max(elapsed[id], Time(0))) / speeds[id];
+		return true;
+	}
+
+	/// Delay a queued tween until the tween before it finishes at its current speed.
+	/// Tweens waiting for a paused tween are held far in the future until it is resumed.
+	/// Paused queued tweens keep their delay, which is recomputed when they are resumed.
+	void schedule_queued(tween_id id) {
+		if (queued_previous[id] == invalid_tween || speeds[id] == 0) {
+			return;
+		}
+		T wait;
+		if (!time_to_finish(queued_previous[id], wait)) {
+			elapsed[id] = std::numeric_limits<Time>::lowest() / 2;
+			return;
+		}
+		T delay = wait * speeds[id];
+		elapsed[id] = -(std::is_integral_v<Time> ? Time(std::ceil(delay)) : Time(delay));
+	}
+
+	/// Recompute the delays of queued tweens after the timing of the tweens before them changed.
+	/// Watches of queued tweens not sharing any tag with `mask` are rescheduled here, the others are left to `reschedule(mask, ...)`.
+	void reschedule_queued(uint64_t mask) {
+		for (tween_id id : queued_ids) {
+			if (!alive(id) || elapsed[id] >= 0) {
+				continue;
+			}
+			schedule_queued(id);
+			if (!(tag_masks[id] & mask)) {
+				generations[id]++;
+				for (const tween_watch& watched : watches) {
+					if (watched.id == id) {
+						schedule(watched, schedule_mode::reschedule);
+					}
+				}
+			}
+		}
+	}
+
+	/// Whether a tween is queued after a paused tween, so it has no known start time
+	bool held(tween_id id) const {
+		T wait;
+		return elapsed[id] < 0 && queued_previous[id] != invalid_tween && !time_to_finish(queued_previous[id], wait);
+	}
+
+	/// Cancel the handover to a removed queued tween, and keep the handover from a removed running tween to the tween queued after it.
+	/// The tween queued after it keeps its start time, unless it was held by a pause, in which case it starts now.
+	void forget_queued_binding(tween_id id) {
+		if (queued_previous[id] != invalid_tween) {
+			queued_next[queued_previous[id]] = invalid_tween;
+		}
+		queued_destinations[id] = nullptr;
+		queued_previous[id] = invalid_tween;
+		if (queued_next[id] != invalid_tween) {
+			tween_id next = queued_next[id];
+			bool was_held = held(next);
+			queued_previous[next] = invalid_tween;
+			queued_next[id] = invalid_tween;
+			if (was_held) {
+				elapsed[next] = 0;
+				reschedule_queued(0);
+			}
+		}
+	}
+
+	struct tween_watch {
+		tween_id id;
+		uint32_t tag;
+		/// Watched threshold as a fraction of the way from the tween's start value to its end value
+		T target;
+	};
+
+	enum class schedule_mode {
+		/// Schedule crossings from the tween's current time on, including the current time
+		watch,
+		/// Schedule crossings after the tween's current time, at its current speed
+		reschedule,
+		/// Make crossings after the tween's current time due now
+		complete,
+	};
+
+	/// Push timers for the crossings of a watched threshold that the tween didn't reach yet.
+	/// Paused tweens get no timers until they are resumed.
+	void schedule(const tween_watch& watched, schedule_mode mode) {
+		tween_id id = watched.id;
+		if (mode != schedule_mode::complete && (speeds[id] == 0 || held(id))) {
+			return;
+		}
+		T progress[max_crossings];
+		int count = 0;
+		if (const fling_decay *fling = find_fling(id)) {
+			// Invert the normalized fling curve (1 - e^(-decay*p)) / (1 - e^(-decay))
+			if (watched.target >= 0 && watched.target <= 1) {
+				progress[count++] = fling->decay > 0 ? -detail::log(1 - watched.target * (1 - detail::exp(-fling->decay))) / fling->decay : watched.target;
+			}
+		}
+		else {
+			count = crossings(curves[id], watched.target, progress);
+		}
+		for (int i = 0; i < count; i++) {
+			T crossing = progress[i] * T(durations[id]);
+			Time crossing_elapsed = std::is_integral_v<Time> ? Time(std::ceil(crossing)) : Time(crossing);
+			if (crossing_elapsed < elapsed[id] || (crossing_elapsed == elapsed[id] && mode != schedule_mode::watch)) {
+				continue;
+			}
+			Time wait = 0;
+			if (mode != schedule_mode::complete) {
+				Time ticks = crossing_elapsed - elapsed[id];
+				if (speeds[id] == 1 && remainders[id] == 0) {
+					wait = ticks;
+				}
+				else if constexpr (std::is_integral_v<Time>) {
+					// Scaled steps carry their remainders, so the tween reaches `ticks` after this many pool ticks
+					wait = Time(std::ceil((T(ticks) - remainders[id]) / speeds[id]));
+				}
+				else {
+					wait = Time(T(ticks) / speeds[id]);
+				}
+			}
+			timers.push_back({ clock + wait, id, generations[id], watched.tag });
+			std::push_heap(timers.begin(), timers.end(), timer_after);
+		}
+	}
+
+	/// Replace the pending timers of watched tweens sharing any tag with `mask`
+	void reschedule(uint64_t mask, schedule_mode mode) {
+		for (const tween_watch& watched : watches) {
+			generations[watched.id] += (tag_masks[watched.id] & mask) != 0;
+		}
+		for (const tween_watch& watched : watches) {
+			if (tag_masks[watched.id] & mask) {
+				schedule(watched, mode);
+			}
+		}
+	}
+
+	void forget_watches(tween_id id) {
+		for (size_t i = 0; i < watches.size();) {
+			if (watches[i].id == id) {
+				watches[i] = watches.back();
+				watches.pop_back();
+			}
+			else {
+				i++;
+			}
+		}
+	}
+
+	std::vector<T> froms;
+	std::vector<T> tos;
+	std::vector<T> values;
+	/// Values as of the last update that reported them changed, which later changes are compared with
+	std::vector<T> reported_values;
+	std::vector<fling_decay> fling_decays;
+
+	struct timer {
+		Time time;
+		tween_id id;
+		uint32_t generation;
+		uint32_t tag;
+	};
+
+	/// Heap ordering for `timers`, with the earliest timer at the front
+	static bool timer_after(const timer& a, const timer& b) {
+		return a.time > b.time;
+	}
+
+	std::vector<T *> destinations;
+	std::vector<tween_id> bound_ids;
+	bool bindings_sorted = true;
+	/// Destination each queued tween takes over when it starts, or `nullptr`
+	std::vector<T *> queued_destinations;
+	/// Tween each queued tween waits for and takes the destination from, or `invalid_tween` once it was removed
+	std::vector<tween_id> queued_previous;
+	/// Tween queued after each tween, or `invalid_tween`
+	std::vector<tween_id> queued_next;
+	/// Queued tweens waiting to start, possibly including removed ones
+	std::vector<tween_id> queued_ids;
+
+	std::vector<property_key> property_keys;
+	std::unordered_map<property_key, tween_id, property_key_hash> property_index;
+
+	std::vector<uint64_t> tag_masks;
+	std::vector<T> time_scales;
+	/// Time scale, or zero for paused tweens
+	std::vector<T> speeds;
+	/// Whether all speeds are 1, so updates can skip scaling time steps
+	bool unit_speed = true;
+	/// Fractions of a tick left over from scaled time steps, used with integer `Time`
+	std::vector<T> remainders;
+
+	std::vector<uint32_t> generations;
+	std::vector<tween_watch> watches;
+	std::vector<timer> timers;
+	std::vector<tween_event<Time>> fired_events;
+	Time clock = 0;
+};
+
+/// Kinds of values animated by a `vector_tween_pool`
+enum class value_kind {
+	/// Single component
+	scalar,
+	/// 2 components, like 2D positions and sizes
+	vec2,
+	/// 3 components, like 3D positions, scales and RGB colors
+	vec3,
+	/// 4 components, like RGBA colors and rectangles
+	vec4,
+	/// Rotation quaternion as `x, y, z, w`, interpolated with normalized lerp along the shortest arc
+	quaternion,
+};
+
+/// Number of kinds in `value_kind`
+inline constexpr int value_kind_count = int(value_kind::quaternion) + 1;
+
+/// Number of components of a value kind
+constexpr int component_count(value_kind kind) {
+	switch (kind) {
+		case value_kind::scalar: return 1;
+		case value_kind::vec2: return 2;
+		case value_kind::vec3: return 3;
+		default: return 4;
+	}
+}
+
+/// Pool of tweens over values with different numbers of components, like scalars, vectors, colors and quaternions.
+/// Each tween has a single timing record and its ease function is evaluated once per update, no matter how many components it has.
+/// Values are kept in one sub-pool per `value_kind`, as densely packed structure of arrays with one array per component,
+/// and the eased amounts are applied to all components in branch-free loops compilers can vectorize.
+///
+/// `Time` is the type used for elapsed time and durations, which defaults to `T`, like in `tween_pool`.
+template<typename T, typename Time = T> class vector_tween_pool : public detail::tween_slots<T, Time> {
+	using base = detail::tween_slots<T, Time>;
+
+public:
+	using base::alive;
+	using base::finished;
+	using base::epsilon;
+	using base::dirty;
+	using base::dirty_mask;
+	using base::changed;
+	using base::capacity;
+	using base::size;
+
+	/// Add a tween that eases from `from` to `to` in `duration` time units with `curve`, starting after `delay` time units.
+	/// `from` and `to` hold `component_count(kind)` components each.
+	/// Quaternion tweens take the shortest arc between `from` and `to`.
+	/// The new tween is reported as changed in the next update.
+	tween_id add(value_kind kind, function curve, const T *from, const T *to, Time duration, Time delay = 0) {
+		tween_id id = allocate(curve, duration, delay);
+		if (kinds.size() < capacity()) {
+			kinds.resize(capacity(), value_kind::scalar);
+			slots.resize(capacity(), 0);
+		}
+		kinds[id] = kind;
+
+		sub_pool& pool = pools[int(kind)];
+		int components = component_count(kind);
+		T sign = 1;
+		if (kind == value_kind::quaternion) {
+			T dot = from[0] * to[0] + from[1] * to[1] + from[2] * to[2] + from[3] * to[3];
+			sign = dot < 0 ? -1 : 1;
+		}
+		slots[id] = uint32_t(pool.owners.size());
+		pool.owners.push_back(id);
+		pool.amounts.push_back(0);
+		pool.deltas.push_back(0);
+		for (int c = 0; c < components; c++) {
+			pool.froms[c].push_back(from[c]);
+			pool.tos[c].push_back(sign * to[c]);
+			pool.values[c].push_back(from[c]);
+			pool.reported[c].push_back(from[c]);
+		}
+		return id;
+	}
+
+	/// Remove a tween, making its identifier available for reuse.
+	/// The last value of the same kind moves into the removed slot, so sub-pools stay densely packed.
+	void remove(tween_id id) {
+		if (!alive(id)) {
+			return;
+		}
+		sub_pool& pool = pools[int(kinds[id])];
+		uint32_t slot = slots[id], last = uint32_t(pool.owners.size() - 1);
+		tween_id moved = pool.owners[last];
+		pool.owners[slot] = moved;
+		slots[moved] = slot;
+		pool.owners.pop_back();
+		pool.amounts.pop_back();
+		pool.deltas.pop_back();
+		for (int c = 0; c < component_count(kinds[id]); c++) {
+			pool.froms[c][slot] = pool.froms[c][last];
+			pool.tos[c][slot] = pool.tos[c][last];
+			pool.values[c][slot] = pool.values[c][last];
+			pool.reported[c][slot] = pool.reported[c][last];
+			pool.froms[c].pop_back();
+			pool.tos[c].pop_back();
+			pool.values[c].pop_back();
+			pool.reported[c].pop_back();
+		}
+		release(id);
+	}
+
+	/// Kind of value animated by a tween
+	value_kind kind(tween_id id) const {
+		return kinds[id];
+	}
+
+	/// Copy the `component_count(kind(id))` components of a tween's current value to `out`
+	void value(tween_id id, T *out) const {
+		const sub_pool& pool = pools[int(kinds[id])];
+		for (int c = 0; c < component_count(kinds[id]); c++) {
+			out[c] = pool.values[c][slots[id]];
+		}
+	}
+
+	/// Advance all tweens by `dt` time units, recomputing their values and the changed index list
+	void update(Time dt) {
+		detail::advance_progress(elapsed.data(), durations.data(), inverse_durations.data(), amounts.data(), elapsed.size(), dt);
+		detail::apply_curves(curves.data(), amounts.data(), elapsed.size());
+		dirty_bits.swap(fresh_bits);
+		std::fill(fresh_bits.begin(), fresh_bits.end(), 0);
+		for (int k = 0; k < value_kind_count; k++) {
+			update_pool(value_kind(k));
+		}
+		collect_changed();
+	}
+
+	/// Values that change by at most `epsilon` in any component in an update are not reported as changed.
+	/// Defaults to 0, so that any change is reported.
+	void set_epsilon(T epsilon) {
+		epsilon_threshold = epsilon;
+	}
+
+	/// Number of tweens of a value kind
+	size_t size(value_kind kind) const {
+		return pools[int(kind)].owners.size();
+	}
+
+	/// Values of component `component` of all tweens of a value kind, packed in the same order as `owners(kind)`
+	const T *data(value_kind kind, int component) const {
+		return pools[int(kind)].values[component].data();
+	}
+
+	/// Tween identifiers of the values of a kind, in the order they are packed in `data`
+	const tween_id *owners(value_kind kind) const {
+		return pools[int(kind)].owners.data();
+	}
+
+private:
+	using base::allocate;
+	using base::release;
+	using base::collect_changed;
+	using base::elapsed;
+	using base::durations;
+	using base::inverse_durations;
+	using base::curves;
+	using base::amounts;
+	using base::fresh_bits;
+	using base::dirty_bits;
+	using base::epsilon_threshold;
+
+	/// Values of one kind, with one array per component
+	struct sub_pool {
+		std::vector<tween_id> owners;
+		std::vector<T> amounts;
+		/// Largest component change of each value in the last update
+		std::vector<T> deltas;
+		/// Inverse lengths of lerped quaternions
+		std::vector<T> scales;
+		std::vector<T> froms[4];
+		std::vector<T> tos[4];
+		std::vector<T> values[4];
+		/// Values as of the last update that reported them changed
+		std::vector<T> reported[4];
+	};
+
+	void update_pool(value_kind kind) {
+		sub_pool& pool = pools[int(kind)];
+		size_t count = pool.owners.size();
+		const tween_id *owner = pool.owners.data();
+		T *amount = pool.amounts.data();
+		T *delta = pool.deltas.data();
+		for (size_t i = 0; i < count; i++) {
+			amount[i] = amounts[owner[i]];
+			delta[i] = 0;
+		}
+		if (kind == value_kind::quaternion) {
+			// Normalized lerp, in separate passes that each stay simple enough to vectorize
+			pool.scales.resize(count);
+			detail::inverse_lerp_lengths(pool.froms, pool.tos, amount, pool.scales.data(), count);
+			for (int c = 0; c < 4; c++) {
+				detail::lerp_component(pool.froms[c].data(), pool.tos[c].data(), amount, pool.scales.data(), pool.values[c].data(), pool.reported[c].data(), delta, count);
+			}
+		}
+		else {
+			for (int c = 0; c < component_count(kind); c++) {
+				detail::lerp_component(pool.froms[c].data(), pool.tos[c].data(), amount, pool.values[c].data(), pool.reported[c].data(), delta, count);
+			}
+		}
+		for (size_t i = 0; i < count; i++) {
+			if (delta[i] > epsilon_threshold) {
+				dirty_bits[owner[i] / 64] |= uint64_t(1) << (owner[i] % 64);
+			}
+		}
+		// Reported values only move with reported changes, so changes smaller than epsilon add up until they are reported
+		for (int c = 0; c < component_count(kind); c++) {
+			const T *value = pool.values[c].data();
+			T *reported = pool.reported[c].data();
+			for (size_t i = 0; i < count; i++) {
+				reported[i] = (dirty_bits[owner[i] / 64] >> (owner[i] % 64)) & 1 ? value[i] : reported[i];
+			}
+		}
+	}
+
+	std::vector<value_kind> kinds;
+	/// Index of each tween's value in the sub-pool of its kind
+	std::vector<uint32_t> slots;
+	sub_pool pools[value_kind_count];
+};
+
+}
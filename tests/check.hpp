@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+
+/// Number of failed checks, returned from `main` by test programs
+inline int check_failures = 0;
+
+/// Report a failed check without stopping the test program
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+			check_failures++; \
+		} \
+	} while (0)
+
+/// Check that two numbers differ by at most `tolerance`
+#define CHECK_NEAR(a, b, tolerance) CHECK(std::abs((a) - (b)) <= (tolerance))
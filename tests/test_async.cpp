@@ -0,0 +1,363 @@
+#include "ease_async.hpp"
+
+#include "check.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ease;
+
+/// Fixed set of worker threads running queued tasks
+class thread_pool {
+public:
+	template<typename Receiver> struct operation {
+		thread_pool *pool;
+		Receiver receiver;
+
+		void start() {
+			pool->push([this] { std::move(receiver).set_value(); });
+		}
+	};
+
+	struct sender {
+		template<template<typename...> class Tuple, template<typename...> class Variant> using value_types = Variant<Tuple<>>;
+		template<template<typename...> class Variant> using error_types = Variant<>;
+		static constexpr bool sends_done = false;
+
+		thread_pool *pool;
+
+		template<typename Receiver> operation<Receiver> connect(Receiver receiver) const {
+			return { pool, std::move(receiver) };
+		}
+	};
+
+	struct scheduler {
+		thread_pool *pool;
+
+		sender schedule() const {
+			return { pool };
+		}
+	};
+
+	explicit thread_pool(int thread_count) {
+		for (int i = 0; i < thread_count; i++) {
+			workers.emplace_back([this] { run(); });
+		}
+	}
+
+	~thread_pool() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			quit = true;
+		}
+		condition.notify_all();
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+	}
+
+	scheduler get_scheduler() {
+		return { this };
+	}
+
+private:
+	std::mutex mutex;
+	std::condition_variable condition;
+	std::deque<std::function<void()>> tasks;
+	std::vector<std::thread> workers;
+	bool quit = false;
+
+	void push(std::function<void()> task) {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			tasks.push_back(std::move(task));
+		}
+		condition.notify_one();
+	}
+
+	void run() {
+		while (true) {
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				condition.wait(lock, [this] { return quit || !tasks.empty(); });
+				if (tasks.empty()) {
+					return;
+				}
+				task = std::move(tasks.front());
+				tasks.pop_front();
+			}
+			task();
+		}
+	}
+};
+
+/// Scheduler whose schedule operations complete with `set_stopped`, like a cancelled run loop
+struct stopped_scheduler {
+	template<typename Receiver> struct operation {
+		Receiver receiver;
+
+		void start() {
+			std::move(receiver).set_stopped();
+		}
+	};
+
+	struct sender {
+		template<template<typename...> class Tuple, template<typename...> class Variant> using value_types = Variant<Tuple<>>;
+		template<template<typename...> class Variant> using error_types = Variant<>;
+		static constexpr bool sends_done = true;
+
+		template<typename Receiver> operation<Receiver> connect(Receiver receiver) const {
+			return { std::move(receiver) };
+		}
+	};
+
+	sender schedule() const {
+		return {};
+	}
+};
+
+/// How a sender completed
+struct completion {
+	std::mutex mutex;
+	std::condition_variable condition;
+	bool done = false;
+	bool value = false;
+	bool stopped = false;
+	std::exception_ptr error;
+	int result = -1;
+};
+
+struct recording_receiver {
+	completion *state;
+
+	void set_value() {
+		finish([this] { state->value = true; });
+	}
+
+	void set_value(int result) {
+		finish([this, result] {
+			state->value = true;
+			state->result = result;
+		});
+	}
+
+	void set_error(std::exception_ptr error) {
+		finish([this, &error] { state->error = std::move(error); });
+	}
+
+	void set_stopped() {
+		finish([this] { state->stopped = true; });
+	}
+
+	template<typename F> void finish(F record) {
+		std::lock_guard<std::mutex> lock(state->mutex);
+		record();
+		state->done = true;
+		state->condition.notify_all();
+	}
+};
+
+/// Start `sender` and block until it completes
+template<typename Sender> void wait_for(const Sender& sender, completion& state) {
+	auto operation = sender.connect(recording_receiver { &state });
+	operation.start();
+	std::unique_lock<std::mutex> lock(state.mutex);
+	state.condition.wait(lock, [&state] { return state.done; });
+}
+
+template<typename Scheduler> static void test_evaluate(Scheduler scheduler) {
+	std::vector<float> p(1000), out(1000, -1), expected(1000);
+	for (size_t i = 0; i < p.size(); i++) {
+		p[i] = float(i) / float(p.size() - 1);
+	}
+	evaluate(OUT_BOUNCE, p.data(), expected.data(), p.size());
+	completion state;
+	wait_for(evaluate_async(scheduler, OUT_BOUNCE, p.data(), out.data(), p.size(), 64), state);
+	CHECK(state.value);
+	CHECK(out == expected);
+}
+
+template<typename Scheduler> static void test_update(Scheduler scheduler) {
+	tween_pool<float> pool, expected;
+	for (int i = 0; i < 1000; i++) {
+		pool.add(IN_OUT_CUBIC, 0, float(i), float(1 + i % 7));
+		expected.add(IN_OUT_CUBIC, 0, float(i), float(1 + i % 7));
+	}
+	for (int frame = 0; frame < 3; frame++) {
+		completion state;
+		wait_for(update_async(scheduler, pool, 0.5f, 64), state);
+		expected.update(0.5f);
+		CHECK(state.value);
+		CHECK(std::equal(pool.data(), pool.data() + pool.capacity(), expected.data()));
+		CHECK(pool.changed() == expected.changed());
+		CHECK(pool.time() == expected.time());
+	}
+}
+
+template<typename Scheduler> static void test_chunk_error(Scheduler scheduler) {
+	bool done_called = false;
+	auto sender = detail::make_bulk_sender(
+		scheduler,
+		[](size_t begin, size_t) {
+			if (begin == 3) {
+				throw std::runtime_error("chunk failed");
+			}
+		},
+		[&done_called] { done_called = true; },
+		8,
+		1
+	);
+	completion state;
+	wait_for(sender, state);
+	CHECK(!state.value);
+	CHECK(!done_called);
+	CHECK(state.error != nullptr);
+	try {
+		std::rethrow_exception(state.error);
+	}
+	catch (const std::runtime_error& error) {
+		CHECK(std::string(error.what()) == "chunk failed");
+	}
+}
+
+static void test_stopped() {
+	std::vector<float> p(100, 0.5f), out(100, -1);
+	completion state;
+	wait_for(evaluate_async(stopped_scheduler(), LINEAR, p.data(), out.data(), p.size(), 10), state);
+	CHECK(state.stopped);
+	CHECK(!state.value);
+	CHECK(state.error == nullptr);
+	CHECK(out[0] == -1);
+}
+
+template<typename Scheduler> static void test_empty_pool(Scheduler scheduler) {
+	tween_pool<float> pool;
+	CHECK(pool.block_count() == 0);
+	completion state;
+	wait_for(update_async(scheduler, pool, 0.25f), state);
+	CHECK(state.value);
+	CHECK(pool.time() == 0.25f);
+	CHECK(pool.changed().empty());
+}
+
+template<typename Scheduler> static void test_then(Scheduler scheduler) {
+	tween_pool<float> pool;
+	for (int i = 0; i < 200; i++) {
+		pool.add(LINEAR, 0, 1, float(1 + i % 2));
+	}
+	completion state;
+	wait_for(then(update_async(scheduler, pool, 1.0f, 64), [&pool] { return int(pool.changed().size()); }), state);
+	CHECK(state.value);
+	CHECK(state.result == 200);
+
+	// Errors skip the follow-up stage
+	bool called = false;
+	auto failing = detail::make_bulk_sender(scheduler, [](size_t, size_t) { throw std::runtime_error("failed"); }, [] {}, 4, 1);
+	completion failed;
+	wait_for(then(failing, [&called] { called = true; }), failed);
+	CHECK(!called);
+	CHECK(failed.error != nullptr);
+
+	// Exceptions thrown by the follow-up stage complete with an error
+	completion throwing;
+	wait_for(then(scheduler.schedule(), []() -> int { throw std::runtime_error("follow-up failed"); }), throwing);
+	CHECK(!throwing.value);
+	CHECK(throwing.error != nullptr);
+
+	completion stopped;
+	wait_for(then(update_async(stopped_scheduler(), pool, 1.0f, 64), [&called] { called = true; }), stopped);
+	CHECK(!called);
+	CHECK(stopped.stopped);
+}
+
+/// Number of times `id` is listed in `changed`
+static size_t listed(const std::vector<tween_id>& changed, tween_id id) {
+	return size_t(std::count(changed.begin(), changed.end(), id));
+}
+
+static void test_pipelined_presentation() {
+	pipelined_tween_pool<float> pool;
+	tween_id id = pool.add(LINEAR, 0, 10, 10);
+	// Each advance presents the frame computed in the background
+	for (int frame = 1; frame <= 3; frame++) {
+		pool.advance(1);
+		CHECK(pool.value(id) == float(frame));
+		CHECK(listed(pool.changed(), id) == 1);
+	}
+}
+
+static void test_pipelined_retarget() {
+	pipelined_tween_pool<float> pool;
+	tween_id id = pool.add(LINEAR, 0, 10, 10);
+	tween_id other = pool.add(LINEAR, 0, 10, 10);
+	pool.advance(1);
+	pool.advance(1);
+	CHECK(pool.value(id) == 2);
+	// The frame in flight is patched, restarting from the current frame's value
+	pool.retarget(id, 20, 10);
+	pool.retarget(id, 20, 10);
+	pool.advance(1);
+	CHECK_NEAR(pool.value(id), 3.8f, 1e-5f);
+	CHECK(pool.value(other) == 3);
+	CHECK(listed(pool.changed(), id) == 1);
+	CHECK(listed(pool.changed(), other) == 1);
+	pool.advance(1);
+	CHECK_NEAR(pool.value(id), 5.6f, 1e-5f);
+	CHECK(listed(pool.changed(), id) == 1);
+}
+
+static void test_pipelined_add_remove_in_flight() {
+	pipelined_tween_pool<float> pool;
+	tween_id first = pool.add(LINEAR, 0, 10, 10);
+	pool.advance(1);
+	// Adding waits for the frame in flight, which didn't advance the new tween
+	tween_id added = pool.add(LINEAR, 5, 15, 10);
+	CHECK(pool.alive(added));
+	pool.advance(1);
+	CHECK(pool.value(added) == 5);
+	CHECK(pool.value(first) == 2);
+	CHECK(listed(pool.changed(), added) == 1);
+	pool.advance(1);
+	CHECK(pool.value(added) == 6);
+
+	pool.remove(first);
+	CHECK(!pool.alive(first));
+	pool.advance(1);
+	CHECK(pool.value(first) == 0);
+	CHECK(listed(pool.changed(), first) == 1);
+	// A tween reusing the removed identifier in the same frame is listed once too
+	pool.advance(1);
+	pool.remove(added);
+	tween_id reused = pool.add(LINEAR, 1, 2, 10);
+	CHECK(reused == added);
+	pool.advance(1);
+	CHECK(pool.value(reused) == 1);
+	CHECK(listed(pool.changed(), reused) == 1);
+}
+
+int main() {
+	thread_pool threads(4);
+	test_evaluate(inline_scheduler());
+	test_evaluate(threads.get_scheduler());
+	test_update(inline_scheduler());
+	test_update(threads.get_scheduler());
+	test_chunk_error(inline_scheduler());
+	test_chunk_error(threads.get_scheduler());
+	test_stopped();
+	test_empty_pool(inline_scheduler());
+	test_empty_pool(threads.get_scheduler());
+	test_then(inline_scheduler());
+	test_then(threads.get_scheduler());
+	test_pipelined_presentation();
+	test_pipelined_retarget();
+	test_pipelined_add_remove_in_flight();
+	return check_failures;
+}
@@ -0,0 +1,26 @@
+#define EASE_COMPACT
+#include "ease.hpp"
+
+#include "check.hpp"
+
+#include <limits>
+
+using namespace ease;
+
+// Compact mode evaluates the same functions as the individual ones, with the precision of `T`
+template<typename T> static void test_compact_matches_functions() {
+	T tolerance = 64 * std::numeric_limits<T>::epsilon();
+	for (int f = 0; f < function_count; f++) {
+		for (int i = 0; i <= 100; i++) {
+			T p = T(i) / 100;
+			CHECK_NEAR(evaluate(function(f), p), get<T>(function(f))(p), tolerance);
+		}
+	}
+}
+
+int main() {
+	test_compact_matches_functions<float>();
+	test_compact_matches_functions<double>();
+	test_compact_matches_functions<long double>();
+	return check_failures;
+}
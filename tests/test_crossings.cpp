@@ -0,0 +1,51 @@
+#include "ease.hpp"
+
+#include "check.hpp"
+
+using namespace ease;
+
+template<typename T> static void check_crossings(function f, T value, std::initializer_list<double> expected, T tolerance) {
+	T out[max_crossings];
+	int count = crossings(f, value, out);
+	CHECK(count == int(expected.size()));
+	int i = 0;
+	for (double crossing : expected) {
+		if (i < count) {
+			CHECK_NEAR(out[i], T(crossing), tolerance);
+		}
+		i++;
+	}
+}
+
+template<typename T> static void test_bounce_joints(T tolerance) {
+	check_crossings<T>(OUT_BOUNCE, 1, { 4 / 11.0, 8 / 11.0, 9 / 10.0, 1 }, tolerance);
+	check_crossings<T>(OUT_BOUNCE, 0, { 0 }, tolerance);
+	check_crossings<T>(IN_BOUNCE, 0, { 0, 1 / 10.0, 3 / 11.0, 7 / 11.0 }, tolerance);
+	check_crossings<T>(IN_BOUNCE, 1, { 1 }, tolerance);
+	check_crossings<T>(IN_OUT_BOUNCE, 0, { 0, 1 / 20.0, 3 / 22.0, 7 / 22.0 }, tolerance);
+	check_crossings<T>(IN_OUT_BOUNCE, 1, { 15 / 22.0, 19 / 22.0, 19 / 20.0, 1 }, tolerance);
+	check_crossings<T>(IN_OUT_BOUNCE, T(0.5), { 0.5 }, tolerance);
+}
+
+template<typename T> static void test_crossings_are_sorted_roots() {
+	const T values[] = { T(-0.2), T(0), T(0.1), T(0.5), T(0.9), T(1), T(1.1) };
+	for (int f = 0; f < function_count; f++) {
+		for (T value : values) {
+			T out[max_crossings];
+			int count = crossings(function(f), value, out);
+			for (int i = 0; i < count; i++) {
+				CHECK_NEAR(evaluate(function(f), out[i]), value, T(1e-4));
+				CHECK(i == 0 || out[i] > out[i - 1]);
+			}
+		}
+	}
+}
+
+int main() {
+	test_bounce_joints<float>(1e-6f);
+	test_bounce_joints<double>(1e-14);
+	test_bounce_joints<long double>(1e-14L);
+	test_crossings_are_sorted_roots<float>();
+	test_crossings_are_sorted_roots<double>();
+	return check_failures;
+}
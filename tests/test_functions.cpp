@@ -0,0 +1,61 @@
+#include "ease.hpp"
+
+#include "check.hpp"
+
+#include <limits>
+#include <type_traits>
+
+using namespace ease;
+
+inline constexpr function SMOOTHSTEP = function(first_custom_function);
+
+template<> struct ease::custom_function<SMOOTHSTEP> {
+	template<typename T> static T evaluate(T p) {
+		return p * p * (3 - 2 * p);
+	}
+	static constexpr function_traits traits = { 0, 1, 0, true, true, true, 4 };
+};
+
+// Exponential functions are usable in constant expressions
+static_assert(in_exponential(0.0) == 0.0);
+static_assert(in_exponential(0.5) == 0.03125);
+static_assert(out_exponential(0.5f) == 0.96875f);
+static_assert(in_out_exponential(1.0) == 1.0);
+static_assert(traits(IN_OUT_EXPONENTIAL).constexpr_evaluable);
+
+template<typename T> static void test_constexpr_power_of_two() {
+	T tolerance = 4 * std::numeric_limits<T>::epsilon();
+	for (int i = -200; i <= 200; i++) {
+		T p = T(i) / 10 + T(0.0123);
+		T expected = std::pow(T(2), p);
+		CHECK(std::abs(detail::constexpr_power_of_two(p) - expected) <= tolerance * expected);
+	}
+}
+
+static void test_visit_custom_function() {
+	bool inlined = false;
+	detail::visit_function<double>(SMOOTHSTEP, [&](auto curve) {
+		inlined = std::is_same_v<decltype(curve), detail::static_function<double, custom_function<SMOOTHSTEP>::evaluate<double>>>;
+	});
+	CHECK(inlined);
+
+	bool dynamic = false;
+	detail::visit_function<double>(function(first_custom_function + 1), [&](auto curve) {
+		dynamic = std::is_same_v<decltype(curve), detail::dynamic_function<double>>;
+	});
+	CHECK(dynamic);
+
+	const double from[] = { 0, 3 }, to[] = { 1, -3 }, p[] = { 0.25, 0.75 };
+	double out[2];
+	interpolate_angles(SMOOTHSTEP, from, to, p, out, 2);
+	CHECK_NEAR(out[0], 0.15625, 1e-12);
+	CHECK_NEAR(out[1], 3 + 0.84375 * (2 * detail::pi<double>() - 6), 1e-12);
+}
+
+int main() {
+	test_constexpr_power_of_two<float>();
+	test_constexpr_power_of_two<double>();
+	test_constexpr_power_of_two<long double>();
+	test_visit_custom_function();
+	return check_failures;
+}
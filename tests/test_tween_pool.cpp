@@ -0,0 +1,296 @@
+#include "ease_tween.hpp"
+
+#include "check.hpp"
+
+#include <cstdint>
+
+using namespace ease;
+
+static void test_integer_time_scale() {
+	tween_pool<float, int32_t> pool;
+	tween_id id = pool.add(LINEAR, 0, 1, 100);
+	pool.set_tags(id, 1);
+	pool.set_time_scale(1, 0.5f);
+	for (int i = 0; i < 50; i++) {
+		pool.update(1);
+	}
+	CHECK_NEAR(pool.value(id), 0.25f, 1e-6f);
+
+	pool.set_time_scale(1, 0.1f);
+	for (int i = 0; i < 100; i++) {
+		pool.update(1);
+	}
+	CHECK_NEAR(pool.value(id), 0.35f, 1e-6f);
+}
+
+static void test_watch_follows_time_scale() {
+	tween_pool<float> pool;
+	tween_id id = pool.add(LINEAR, 0, 10, 10);
+	pool.set_tags(id, 1);
+	pool.watch(id, 5, 7);
+	pool.update(2);
+	pool.pause(1);
+	pool.update(10);
+	CHECK(pool.events().empty());
+	pool.resume(1);
+	pool.update(2);
+	CHECK(pool.events().empty());
+	pool.update(1);
+	CHECK(pool.events().size() == 1);
+	CHECK(!pool.events().empty() && pool.events()[0].tag == 7 && pool.events()[0].time == 15);
+
+	tween_id slow = pool.add(LINEAR, 0, 10, 10);
+	pool.set_tags(slow, 2);
+	pool.watch(slow, 5, 8);
+	pool.set_time_scale(2, 0.5f);
+	int fired_at = -1;
+	for (int i = 1; i <= 20 && fired_at < 0; i++) {
+		pool.update(1);
+		if (!pool.events().empty()) {
+			fired_at = i;
+		}
+	}
+	CHECK(fired_at == 10);
+}
+
+static void test_watch_integer_time_scale() {
+	tween_pool<float, int32_t> pool;
+	tween_id id = pool.add(LINEAR, 0, 10, 10);
+	pool.set_tags(id, 1);
+	pool.set_time_scale(1, 0.5f);
+	pool.watch(id, 5, 0);
+	int fired_at = -1;
+	for (int i = 1; i <= 30 && fired_at < 0; i++) {
+		pool.update(1);
+		if (!pool.events().empty()) {
+			fired_at = i;
+		}
+	}
+	CHECK(fired_at == 10);
+	CHECK_NEAR(pool.value(id), 5.0f, 1e-5f);
+}
+
+static void test_complete_fires_pending_watches() {
+	tween_pool<float> pool;
+	tween_id id = pool.add(LINEAR, 0, 10, 10);
+	pool.set_tags(id, 1);
+	pool.watch(id, 1, 1);
+	pool.watch(id, 5, 5);
+	pool.watch(id, 8, 8);
+	pool.update(2);
+	CHECK(pool.events().size() == 1);
+	pool.complete(1);
+	pool.update(1);
+	CHECK(pool.events().size() == 2);
+	CHECK(pool.value(id) == 10);
+	pool.update(10);
+	CHECK(pool.events().empty());
+}
+
+static void test_queue_keeps_destination_until_start() {
+	tween_pool<float> pool;
+	int target = 0;
+	float destination = -1;
+	tween_id first = pool.animate(&target, 0, LINEAR, 0, 10, 10);
+	pool.bind(first, &destination);
+	pool.update(5);
+	CHECK(destination == 5);
+
+	tween_id queued = pool.animate(&target, 0, LINEAR, 0, 20, 10, overwrite::queue);
+	CHECK(pool.find(&target, 0) == queued);
+	pool.update(1);
+	CHECK(destination == 6);
+	CHECK(!pool.dirty(queued));
+	pool.update(3);
+	CHECK(destination == 9);
+	pool.update(1);
+	CHECK(destination == 10);
+	pool.update(5);
+	CHECK(destination == 15);
+	CHECK(pool.dirty(queued));
+	pool.update(5);
+	CHECK(destination == 20);
+
+	// Replacing a queued tween removes the running one too, leaving the first finished tween and the replacement
+	tween_id running = pool.animate(&target, 0, LINEAR, 0, 10, 10);
+	pool.bind(running, &destination);
+	pool.animate(&target, 0, LINEAR, 0, 20, 10, overwrite::queue);
+	tween_id replacement = pool.animate(&target, 0, LINEAR, 100, 200, 10);
+	pool.update(5);
+	CHECK(destination == 150);
+	CHECK(pool.find(&target, 0) == replacement);
+	CHECK(pool.size() == 2);
+}
+
+static void test_blend_over_queued_tween() {
+	tween_pool<float> pool;
+	int target = 0;
+	float destination = -1;
+	tween_id running = pool.animate(&target, 0, LINEAR, 0, 10, 10);
+	pool.bind(running, &destination);
+	pool.update(5);
+	pool.animate(&target, 0, LINEAR, 0, 20, 10, overwrite::queue);
+	pool.animate(&target, 0, LINEAR, 0, 100, 10, overwrite::blend);
+	// Both the running tween and the queued one were overwritten
+	CHECK(pool.size() == 1);
+	pool.update(1);
+	CHECK_NEAR(destination, 14.5f, 1e-5f);
+	pool.update(9);
+	CHECK(destination == 100);
+}
+
+static void test_queue_after_removed_tween() {
+	tween_pool<float> pool;
+	int target = 0;
+	float destination = -1;
+	tween_id first = pool.animate(&target, 0, LINEAR, 0, 10, 10);
+	pool.bind(first, &destination);
+	pool.update(5);
+	pool.animate(&target, 0, LINEAR, 0, 20, 10, overwrite::queue);
+	pool.remove(first);
+	pool.update(1);
+	CHECK(destination == 5);
+	pool.update(9);
+	CHECK(destination == 15);
+}
+
+static void test_queue_waits_for_paused_tween() {
+	tween_pool<float> pool;
+	int target = 0;
+	float destination = -1;
+	tween_id first = pool.animate(&target, 0, LINEAR, 0, 10, 10);
+	pool.bind(first, &destination);
+	pool.set_tags(first, 1);
+	pool.update(2);
+	tween_id queued = pool.animate(&target, 0, LINEAR, 0, 20, 10, overwrite::queue);
+	pool.set_tags(queued, 2);
+	pool.pause(1);
+	pool.update(10);
+	CHECK(destination == 2);
+	CHECK(pool.value(queued) == 10);
+	pool.update(100);
+	CHECK(destination == 2);
+}
+
+static void test_queue_follows_resume() {
+	tween_pool<float> pool;
+	int target = 0;
+	float destination = -1;
+	tween_id first = pool.animate(&target, 0, LINEAR, 0, 10, 10);
+	pool.bind(first, &destination);
+	pool.set_tags(first, 1);
+	pool.update(2);
+	tween_id queued = pool.animate(&target, 0, LINEAR, 0, 20, 10, overwrite::queue);
+	pool.set_tags(queued, 2);
+	pool.pause(1);
+	pool.update(10);
+	pool.resume(1);
+	pool.update(7);
+	CHECK(destination == 9);
+	pool.update(1);
+	CHECK(destination == 10);
+	pool.update(5);
+	CHECK(destination == 15);
+	CHECK(!pool.alive(first) || pool.finished(first));
+
+	// Pausing both tweens keeps the queued one's delay until they are resumed
+	int other = 0;
+	float other_destination = -1;
+	tween_id running = pool.animate(&other, 0, LINEAR, 0, 10, 10);
+	pool.bind(running, &other_destination);
+	pool.set_tags(running, 4);
+	pool.update(2);
+	pool.animate(&other, 0, LINEAR, 0, 20, 10, overwrite::queue);
+	pool.pause(4);
+	pool.update(10);
+	CHECK(other_destination == 2);
+	pool.resume(4);
+	pool.update(13);
+	CHECK(other_destination == 15);
+}
+
+static void test_queue_follows_time_scale() {
+	tween_pool<float> pool;
+	int target = 0;
+	float destination = -1;
+	tween_id first = pool.animate(&target, 0, LINEAR, 0, 10, 10);
+	pool.bind(first, &destination);
+	pool.set_tags(first, 1);
+	pool.update(2);
+	pool.animate(&target, 0, LINEAR, 0, 20, 10, overwrite::queue);
+	pool.set_time_scale(1, 0.5f);
+	// The queued tween copied the tags, so it runs at half speed too once it starts after 16 more time units
+	pool.update(15);
+	CHECK_NEAR(destination, 9.5f, 1e-5f);
+	pool.update(1);
+	CHECK_NEAR(destination, 10, 1e-5f);
+	pool.update(2);
+	CHECK_NEAR(destination, 11, 1e-5f);
+}
+
+static void test_queue_follows_complete() {
+	tween_pool<float> pool;
+	int target = 0;
+	float destination = -1;
+	tween_id first = pool.animate(&target, 0, LINEAR, 0, 10, 10);
+	pool.bind(first, &destination);
+	pool.set_tags(first, 1);
+	pool.update(2);
+	tween_id queued = pool.animate(&target, 0, LINEAR, 0, 20, 10, overwrite::queue);
+	pool.set_tags(queued, 2);
+	pool.complete(1);
+	pool.update(1);
+	CHECK(destination == 11);
+	CHECK(pool.dirty(queued));
+	pool.update(9);
+	CHECK(destination == 20);
+}
+
+static void test_epsilon_accumulates_slow_changes() {
+	tween_pool<float> pool;
+	pool.set_epsilon(1e-3f);
+	float destination = -1;
+	tween_id id = pool.add(LINEAR, 0, 1, 10000);
+	pool.bind(id, &destination);
+	int reports = 0;
+	for (int i = 0; i < 10000; i++) {
+		pool.update(1);
+		reports += pool.dirty(id);
+	}
+	CHECK_NEAR(destination, 1, 1e-3f);
+	CHECK(reports > 100);
+
+	vector_tween_pool<float> vectors;
+	vectors.set_epsilon(1e-3f);
+	const float from[2] = {0, 0};
+	const float to[2] = {1, -1};
+	tween_id vector = vectors.add(value_kind::vec2, LINEAR, from, to, 10000);
+	float reported[2] = {-1, -1};
+	reports = 0;
+	for (int i = 0; i < 10000; i++) {
+		vectors.update(1);
+		if (vectors.dirty(vector)) {
+			vectors.value(vector, reported);
+			reports++;
+		}
+	}
+	CHECK_NEAR(reported[0], 1, 1e-3f);
+	CHECK_NEAR(reported[1], -1, 1e-3f);
+	CHECK(reports > 100);
+}
+
+int main() {
+	test_integer_time_scale();
+	test_watch_follows_time_scale();
+	test_watch_integer_time_scale();
+	test_complete_fires_pending_watches();
+	test_queue_keeps_destination_until_start();
+	test_queue_after_removed_tween();
+	test_blend_over_queued_tween();
+	test_queue_waits_for_paused_tween();
+	test_queue_follows_resume();
+	test_queue_follows_time_scale();
+	test_queue_follows_complete();
+	test_epsilon_accumulates_slow_changes();
+	return check_failures;
+}